@@ -1,9 +1,17 @@
 #include "gdal_dataset_factory.hpp"
+#include "gdal_module.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/object_cache.hpp"
 #include "gdal_priv.h"
 
 namespace duckdb {
 
-GDALDataset *GDALDatasetFactory::FromFile(const std::string &file_path, const std::vector<std::string> &allowed_drivers,
+GDALDataset *GDALDatasetFactory::FromFile(ClientContext &context, const std::string &file_path,
+                                          const std::vector<std::string> &allowed_drivers,
                                           const std::vector<std::string> &open_options,
                                           const std::vector<std::string> &sibling_files) {
 
@@ -11,18 +19,220 @@ GDALDataset *GDALDatasetFactory::FromFile(const std::string &file_path, const st
 	auto gdal_open_options = GDALDatasetFactory::FromVectorOfStrings(open_options);
 	auto gdal_sibling_files = GDALDatasetFactory::FromVectorOfStrings(sibling_files);
 
-	GDALDataset *dataset = GDALDataset::Open(file_path.c_str(), GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
-	                                         gdal_allowed_drivers.empty() ? nullptr : gdal_allowed_drivers.data(),
-	                                         gdal_open_options.empty() ? nullptr : gdal_open_options.data(),
-	                                         gdal_sibling_files.empty() ? nullptr : gdal_sibling_files.data());
+	GDALDataset *dataset = GDALDatasetFactory::Open(
+	    context, file_path, gdal_allowed_drivers.empty() ? nullptr : gdal_allowed_drivers.data(),
+	    gdal_open_options.empty() ? nullptr : gdal_open_options.data(),
+	    gdal_sibling_files.empty() ? nullptr : gdal_sibling_files.data());
 
 	return dataset;
 }
 
+namespace {
+
+//! Size of the signature read from the header of a file to tell apart formats sharing an extension (e.g. netCDF-3
+//! and HDF5 based netCDF-4 files, or GeoTIFF and BigTIFF)
+constexpr size_t DRIVER_HINT_SIGNATURE_SIZE = 4;
+
+//! Remembers which driver opened the last file of each kind in a database, so later opens of similar files can skip
+//! probing the whole list of drivers. Files are grouped by the virtual file system prefix, the extension and the
+//! signature of their header.
+class GDALDriverHintCache final : public ObjectCacheEntry {
+public:
+	static std::string ObjectType() {
+		return "gdal_driver_hints";
+	}
+
+	std::string GetObjectType() override {
+		return ObjectType();
+	}
+
+	static GDALDriverHintCache &Get(ClientContext &context) {
+		return *ObjectCache::GetObjectCache(context).GetOrCreate<GDALDriverHintCache>(ObjectType());
+	}
+
+	//! Returns the key of a file, or an empty string when it has no extension or its header can not be read
+	static std::string GetKey(const std::string &file_path, unsigned int open_flags) {
+		std::string extension = CPLGetExtension(file_path.c_str());
+		if (extension.empty()) {
+			return std::string();
+		}
+
+		std::string prefix;
+		if (StringUtil::StartsWith(file_path, "/vsi")) {
+			auto pos = file_path.find('/', 1);
+			prefix = file_path.substr(0, pos == std::string::npos ? file_path.size() : pos);
+		}
+
+		// Remote files keep the header in the cache of their file system, so the driver reads it again for free
+		auto file = VSIFOpenL(file_path.c_str(), "rb");
+		if (!file) {
+			return std::string();
+		}
+		unsigned char header[DRIVER_HINT_SIGNATURE_SIZE];
+		auto size = VSIFReadL(header, 1, DRIVER_HINT_SIGNATURE_SIZE, file);
+		VSIFCloseL(file);
+
+		if (size != DRIVER_HINT_SIGNATURE_SIZE) {
+			return std::string();
+		}
+		std::string signature;
+		for (auto byte : header) {
+			signature += StringUtil::Format("%02x", byte);
+		}
+		return StringUtil::Format("%s:%s:%s:%u", prefix, StringUtil::Lower(extension), signature, open_flags);
+	}
+
+	std::string GetDriver(const std::string &key) {
+		lock_guard<mutex> guard(lock);
+		auto entry = hints.find(key);
+		return entry != hints.end() ? entry->second : std::string();
+	}
+
+	void SetDriver(const std::string &key, const std::string &driver_name) {
+		lock_guard<mutex> guard(lock);
+		hints[key] = driver_name;
+	}
+
+private:
+	mutex lock;
+	unordered_map<std::string, std::string> hints;
+};
+
+//! Opens a GDALDataset, registering the rest of GDAL drivers when the ones loaded at startup can not open it
+GDALDataset *OpenDataset(const std::string &file_path, unsigned int open_flags, const char *const *allowed_drivers,
+                         const char *const *open_options, const char *const *sibling_files) {
+	GDALDataset *dataset = nullptr;
+
+	if (!GdalModule::AllDriversRegistered()) {
+		bool fast_path = GdalModule::IsFastPathFile(file_path);
+
+		for (auto driver_name = allowed_drivers; fast_path && driver_name && *driver_name; ++driver_name) {
+			fast_path = GetGDALDriverManager()->GetDriverByName(*driver_name) != nullptr;
+		}
+
+		// Try first with the drivers loaded at startup, without reporting errors if none of them recognizes the file
+		if (fast_path) {
+			dataset = GDALDataset::Open(file_path.c_str(), open_flags, allowed_drivers, open_options, sibling_files);
+		}
+		if (!dataset) {
+			GdalModule::RegisterAllDrivers();
+		}
+	}
+	if (!dataset) {
+		dataset = GDALDataset::Open(file_path.c_str(), open_flags | GDAL_OF_VERBOSE_ERROR, allowed_drivers,
+		                            open_options, sibling_files);
+	}
+	return dataset;
+}
+
+} // namespace
+
+GDALDataset *GDALDatasetFactory::Open(ClientContext &context, const std::string &file_path,
+                                      const char *const *allowed_drivers, const char *const *open_options,
+                                      const char *const *sibling_files, unsigned int open_flags) {
+	open_flags = open_flags ? open_flags : GDAL_OF_RASTER;
+
+	// Without an explicit list of drivers, try first the driver that opened the last file of the same kind
+	auto hint_key = allowed_drivers ? std::string() : GDALDriverHintCache::GetKey(file_path, open_flags);
+
+	if (!hint_key.empty()) {
+		auto driver_name = GDALDriverHintCache::Get(context).GetDriver(hint_key);
+
+		if (!driver_name.empty()) {
+			const char *const hint_drivers[] = {driver_name.c_str(), nullptr};
+
+			auto dataset = GDALDataset::Open(file_path.c_str(), open_flags, hint_drivers, open_options, sibling_files);
+			if (dataset) {
+				return dataset;
+			}
+		}
+	}
+
+	auto dataset = OpenDataset(file_path, open_flags, allowed_drivers, open_options, sibling_files);
+
+	if (dataset && dataset->GetDriver() && !hint_key.empty()) {
+		GDALDriverHintCache::Get(context).SetDriver(hint_key, dataset->GetDriver()->GetDescription());
+	}
+	return dataset;
+}
+
+std::string GDALDatasetFactory::GetDriverHint(ClientContext &context, const std::string &file_path,
+                                              unsigned int open_flags) {
+	auto hint_key = GDALDriverHintCache::GetKey(file_path, open_flags ? open_flags : GDAL_OF_RASTER);
+	return hint_key.empty() ? std::string() : GDALDriverHintCache::Get(context).GetDriver(hint_key);
+}
+
+GDALDataset *GDALDatasetFactory::Reopen(GDALDataset *dataset) {
+	auto driver = dataset->GetDriver();
+	auto file_path = std::string(dataset->GetDescription());
+
+	if (driver == nullptr || file_path.empty() || EQUAL(driver->GetDescription(), "MEM")) {
+		return nullptr;
+	}
+
+	VSIStatBufL stat_buffer;
+	if (VSIStatL(file_path.c_str(), &stat_buffer) != 0) {
+		return nullptr;
+	}
+
+	auto allowed_drivers = std::vector<std::string>();
+	allowed_drivers.emplace_back(driver->GetDescription());
+
+	// Reopened handles are used by parallel readers, so they do not decode blocks with extra threads
+	auto open_options = std::vector<std::string>();
+	for (auto options = dataset->GetOpenOptions(); options && *options; ++options) {
+		if (!StringUtil::StartsWith(StringUtil::Upper(*options), "NUM_THREADS=")) {
+			open_options.emplace_back(*options);
+		}
+	}
+
+	auto gdal_allowed_drivers = GDALDatasetFactory::FromVectorOfStrings(allowed_drivers);
+	auto gdal_open_options = GDALDatasetFactory::FromVectorOfStrings(open_options);
+
+	try {
+		auto reopened = GDALDatasetUniquePtr(OpenDataset(file_path, GDAL_OF_RASTER, gdal_allowed_drivers.data(),
+		                                                 gdal_open_options.empty() ? nullptr : gdal_open_options.data(),
+		                                                 nullptr));
+
+		// E.g. a view of an overview level, the new handle must read the same grid of pixels
+		if (reopened && (reopened->GetRasterXSize() != dataset->GetRasterXSize() ||
+		                 reopened->GetRasterYSize() != dataset->GetRasterYSize() ||
+		                 reopened->GetRasterCount() != dataset->GetRasterCount())) {
+			return nullptr;
+		}
+		return reopened.release();
+	} catch (std::exception &) {
+		// The GDAL error handler throws, just fall back to the shared handle
+		return nullptr;
+	}
+}
+
+idx_t GDALDatasetFactory::GetNumThreads(ClientContext &context, int64_t num_threads, idx_t reader_count) {
+	if (num_threads < 0) {
+		throw InvalidInputException("The number of threads must be zero (all threads) or a positive number");
+	}
+
+	// Keep the total number of decoding threads of all readers within the budget of DuckDB
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	auto thread_count = MaxValue<idx_t>(1, NumericCast<idx_t>(scheduler.NumberOfThreads()));
+	auto max_threads = MaxValue<idx_t>(1, thread_count / MaxValue<idx_t>(1, reader_count));
+
+	return num_threads == 0 ? max_threads : MinValue<idx_t>(NumericCast<idx_t>(num_threads), max_threads);
+}
+
+std::string GDALDatasetFactory::GetNumThreadsOption(ClientContext &context, int64_t num_threads,
+                                                    idx_t reader_count) {
+	return StringUtil::Format("NUM_THREADS=%llu", GetNumThreads(context, num_threads, reader_count));
+}
+
 bool GDALDatasetFactory::WriteFile(GDALDataset *dataset, const std::string &file_path, const std::string &driver_name,
                                    const std::vector<std::string> &write_options) {
 	auto driver = GetGDALDriverManager()->GetDriverByName(driver_name.c_str());
 
+	if (!driver && !GdalModule::AllDriversRegistered()) {
+		GdalModule::RegisterAllDrivers();
+		driver = GetGDALDriverManager()->GetDriverByName(driver_name.c_str());
+	}
 	if (!driver) {
 		throw InvalidInputException("Unknown driver '%s'", driver_name.c_str());
 	}
@@ -6,16 +6,40 @@ class GDALDataset;
 
 namespace duckdb {
 
+class ClientContext;
+
 //! A factory of Rasters (GDALDatasets) from several data source types.
 //! Does not take ownership of the pointer.
 class GDALDatasetFactory {
 public:
 	//! Given a file path, returns a GDALDataset
-	static GDALDataset *FromFile(const std::string &file_path,
+	static GDALDataset *FromFile(ClientContext &context, const std::string &file_path,
 	                             const std::vector<std::string> &allowed_drivers = std::vector<std::string>(),
 	                             const std::vector<std::string> &open_options = std::vector<std::string>(),
 	                             const std::vector<std::string> &sibling_files = std::vector<std::string>());
 
+	//! Opens a GDALDataset, registering the rest of GDAL drivers when the ones loaded at startup can not open it.
+	//! The lists are null-terminated arrays of strings as expected by GDAL, or nullptr. The open flags are the
+	//! GDAL_OF_* kind of dataset to open, GDAL_OF_RASTER when zero.
+	//! Without a list of allowed drivers, the driver that opened the last file of the same kind (file system, extension
+	//! and header signature) in the database is tried first.
+	static GDALDataset *Open(ClientContext &context, const std::string &file_path, const char *const *allowed_drivers,
+	                         const char *const *open_options, const char *const *sibling_files,
+	                         unsigned int open_flags = 0);
+
+	//! Returns the driver tried first to open a file without a list of allowed drivers, or an empty string if none.
+	static std::string GetDriverHint(ClientContext &context, const std::string &file_path, unsigned int open_flags = 0);
+
+	//! Opens a new independent handle of a file-based GDALDataset, useful to read it from several threads.
+	//! Returns nullptr when the dataset can not be reopened (e.g. MEM or in-memory VRT datasets).
+	static GDALDataset *Reopen(GDALDataset *dataset);
+
+	//! Returns the number of threads to decode the blocks of a file, capped to the DuckDB thread budget shared by the
+	//! given number of concurrent readers. Zero means all threads.
+	static idx_t GetNumThreads(ClientContext &context, int64_t num_threads, idx_t reader_count = 1);
+	//! Returns the open option enabling multi-threaded block decoding (NUM_THREADS=n), see GetNumThreads.
+	static std::string GetNumThreadsOption(ClientContext &context, int64_t num_threads, idx_t reader_count = 1);
+
 	//! Writes a GDALDataset to a file path
 	static bool WriteFile(GDALDataset *dataset, const std::string &file_path, const std::string &driver_name = "COG",
 	                      const std::vector<std::string> &write_options = std::vector<std::string>());
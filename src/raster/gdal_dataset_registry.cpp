@@ -12,10 +12,20 @@ GDALDatasetRegistry::~GDALDatasetRegistry() {
 		auto datasetUniquePtr = std::move(*it);
 		datasetUniquePtr.reset();
 	}
+	for (auto &file_path : temporary_files_) {
+		VSIUnlink(file_path.c_str());
+	}
 }
 
 void GDALDatasetRegistry::RegisterDataset(GDALDataset *dataset) {
+	std::lock_guard<std::mutex> guard(lock_);
+	datasets_.emplace_back(GDALDatasetUniquePtr(dataset));
+}
+
+void GDALDatasetRegistry::RegisterTemporaryDataset(GDALDataset *dataset, const std::string &file_path) {
+	std::lock_guard<std::mutex> guard(lock_);
 	datasets_.emplace_back(GDALDatasetUniquePtr(dataset));
+	temporary_files_.emplace_back(file_path);
 }
 
 } // namespace duckdb
@@ -2,10 +2,12 @@
 
 #include "gdal_priv.h"
 
+#include <mutex>
+
 namespace duckdb {
 
 //! A registry of Rasters (GDALDatasets) where items are released.
-//! This takes ownership of items registered.
+//! This takes ownership of items registered, and it can be used from several threads.
 class GDALDatasetRegistry {
 public:
 	//! Constructor
@@ -15,9 +17,13 @@ public:
 
 	//! Register a GDALDataset
 	void RegisterDataset(GDALDataset *dataset);
+	//! Register a GDALDataset stored in a temporary file, the file is deleted when the dataset is released
+	void RegisterTemporaryDataset(GDALDataset *dataset, const std::string &file_path);
 
 private:
+	std::mutex lock_;
 	std::vector<GDALDatasetUniquePtr> datasets_;
+	std::vector<std::string> temporary_files_;
 };
 
 } // namespace duckdb
@@ -1,22 +1,38 @@
 #include "gdal_module.hpp"
+#include "duckdb/common/string_util.hpp"
 #include "duckdb/main/extension_util.hpp"
 
 // GDAL
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_error.h"
+#include "gdal_frmts.h"
 #include "gdal_priv.h"
+#include "ogrsf_frmts.h"
+#include <atomic>
 #include <mutex>
 
 namespace duckdb {
 
+namespace {
+
+std::atomic<bool> all_drivers_registered(false);
+
+} // namespace
+
 void GdalModule::Register(DatabaseInstance &db) {
 
 	// Load GDAL (once)
 	static std::once_flag loaded;
 	std::call_once(loaded, [&]() {
-		// Register all embedded drivers (dont go looking for plugins)
-		GDALAllRegister();
+		// Register only the drivers of the common formats and the ones used internally by the extension,
+		// the rest of embedded drivers are registered on first need (see RegisterAllDrivers)
+		GDALRegister_GTiff();
+		GDALRegister_COG();
+		GDALRegister_HFA();
+		GDALRegister_VRT();
+		GDALRegister_MEM();
+		RegisterOGRMEM();
 
 		// Set GDAL error handler
 		CPLSetErrorHandler([](CPLErr e, int code, const char *raw_msg) {
@@ -59,4 +75,24 @@ void GdalModule::Register(DatabaseInstance &db) {
 	});
 }
 
+void GdalModule::RegisterAllDrivers() {
+	static std::once_flag registered;
+	std::call_once(registered, []() {
+		// Register all embedded drivers (dont go looking for plugins), already registered ones are skipped
+		GDALAllRegister();
+		all_drivers_registered = true;
+	});
+}
+
+bool GdalModule::AllDriversRegistered() {
+	return all_drivers_registered;
+}
+
+bool GdalModule::IsFastPathFile(const std::string &file_path) {
+	// VRTs are not included, their sources can be of any format and are opened lazily by GDAL
+	auto lower_name = StringUtil::Lower(file_path);
+	return StringUtil::EndsWith(lower_name, ".tif") || StringUtil::EndsWith(lower_name, ".tiff") ||
+	       StringUtil::EndsWith(lower_name, ".img");
+}
+
 } // namespace duckdb
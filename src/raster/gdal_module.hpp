@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 namespace duckdb {
 
 class DatabaseInstance;
@@ -7,6 +9,14 @@ class DatabaseInstance;
 struct GdalModule {
 public:
 	static void Register(DatabaseInstance &db);
+
+	//! Registers all embedded GDAL drivers (once). Only the drivers of the common formats are registered when the
+	//! extension is loaded, the rest are registered on first need to keep the load time low.
+	static void RegisterAllDrivers();
+	//! Returns true if all embedded GDAL drivers are already registered
+	static bool AllDriversRegistered();
+	//! Returns true if the file is expected to be opened by the drivers registered when the extension is loaded
+	static bool IsFastPathFile(const std::string &file_path);
 };
 
 } // namespace duckdb
@@ -1,8 +1,389 @@
 #include "gdal_priv.h"
+#include "gdal_utils.h"
+#include "gdalwarper.h"
+#include "ogr_geometry.h"
+#include "ogr_spatialref.h"
 #include "raster.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace duckdb {
 
+namespace {
+
+//! Transforms coordinates from the coordinate system of a Raster to its pixel/line space.
+class GeoToPixelTransformation final : public OGRCoordinateTransformation {
+public:
+	explicit GeoToPixelTransformation(const double inv_gt[6]) {
+		std::copy(inv_gt, inv_gt + 6, this->inv_gt);
+	}
+
+	const OGRSpatialReference *GetSourceCS() const override {
+		return nullptr;
+	}
+	const OGRSpatialReference *GetTargetCS() const override {
+		return nullptr;
+	}
+
+	int Transform(size_t count, double *x, double *y, double *z, double *t, int *success) override {
+		for (size_t i = 0; i < count; i++) {
+			double px = inv_gt[0] + x[i] * inv_gt[1] + y[i] * inv_gt[2];
+			double py = inv_gt[3] + x[i] * inv_gt[4] + y[i] * inv_gt[5];
+			x[i] = px;
+			y[i] = py;
+			if (success) {
+				success[i] = TRUE;
+			}
+		}
+		return TRUE;
+	}
+
+	OGRCoordinateTransformation *Clone() const override {
+		return new GeoToPixelTransformation(inv_gt);
+	}
+	OGRCoordinateTransformation *GetInverse() const override {
+		return nullptr;
+	}
+
+private:
+	double inv_gt[6];
+};
+
+//! Returns a NODATA value for a band without one that no valid pixel can have, without reading the band: NaN for
+//! floating point bands. Returns false for other bands, whose pixels outside a geometry must be masked otherwise.
+bool GetUnusedNoDataValue(GDALRasterBand *band, double &nodata_value) {
+	auto data_type = band->GetRasterDataType();
+
+	if (GDALDataTypeIsComplex(data_type) || !GDALDataTypeIsFloating(data_type)) {
+		return false;
+	}
+	nodata_value = std::numeric_limits<double>::quiet_NaN();
+	return true;
+}
+
+} // namespace
+
+Raster::Raster(GDALDataset *dataset) : dataset(dataset) {
+}
+
+int Raster::GetRasterXSize() const {
+	return dataset->GetRasterXSize();
+}
+
+int Raster::GetRasterYSize() const {
+	return dataset->GetRasterYSize();
+}
+
+int Raster::GetRasterCount() const {
+	return dataset->GetRasterCount();
+}
+
+void Raster::GetGeoTransform(double gt[6]) const {
+	if (dataset->GetGeoTransform(gt) != CE_None) {
+		gt[0] = 0;
+		gt[1] = 1;
+		gt[2] = 0;
+		gt[3] = 0;
+		gt[4] = 0;
+		gt[5] = 1;
+	}
+}
+
+std::vector<RasterWindow> Raster::GetTiles(int band_number, int min_tile_size) const {
+	int cols = dataset->GetRasterXSize();
+	int rows = dataset->GetRasterYSize();
+
+	int block_x = cols;
+	int block_y = 1;
+
+	if (band_number >= 1 && band_number <= dataset->GetRasterCount()) {
+		dataset->GetRasterBand(band_number)->GetBlockSize(&block_x, &block_y);
+	}
+
+	// Group blocks until reaching the minimum tile size (e.g. scanline or strip based files)
+	int tile_x = block_x >= min_tile_size ? block_x : ((min_tile_size + block_x - 1) / block_x) * block_x;
+	int tile_y = block_y >= min_tile_size ? block_y : ((min_tile_size + block_y - 1) / block_y) * block_y;
+	tile_x = std::max(1, std::min(tile_x, cols));
+	tile_y = std::max(1, std::min(tile_y, rows));
+
+	std::vector<RasterWindow> tiles;
+	for (int y = 0; y < rows; y += tile_y) {
+		for (int x = 0; x < cols; x += tile_x) {
+			tiles.emplace_back(x, y, std::min(tile_x, cols - x), std::min(tile_y, rows - y));
+		}
+	}
+	return tiles;
+}
+
+bool Raster::HasSameGrid(GDALDataset *other) const {
+	if (dataset->GetRasterXSize() != other->GetRasterXSize() || dataset->GetRasterYSize() != other->GetRasterYSize()) {
+		return false;
+	}
+
+	double gt[6];
+	double other_gt[6];
+	GetGeoTransform(gt);
+	Raster(other).GetGeoTransform(other_gt);
+
+	// Pixel sizes and rotations must match closely, origins up to a tiny fraction of a pixel
+	double pixel_size =
+	    std::max(std::max(std::fabs(gt[1]), std::fabs(gt[2])), std::max(std::fabs(gt[4]), std::fabs(gt[5])));
+	double coefficient_tolerance = 1e-6 * pixel_size;
+	double origin_tolerance = 1e-3 * pixel_size;
+
+	for (int i = 0; i < 6; i++) {
+		double tolerance = (i == 0 || i == 3) ? origin_tolerance : coefficient_tolerance;
+		if (std::fabs(gt[i] - other_gt[i]) > tolerance) {
+			return false;
+		}
+	}
+
+	return HasSameSpatialRef(other->GetSpatialRef());
+}
+
+bool Raster::HasSameSpatialRef(const OGRSpatialReference *srs) const {
+	// Without both coordinate systems, they are assumed to be the same one
+	auto raster_srs = dataset->GetSpatialRef();
+	return !raster_srs || !srs || raster_srs->IsSame(srs);
+}
+
+int Raster::GetOverviewLevel(double target_resolution) const {
+	if (dataset->GetRasterCount() == 0) {
+		return -1;
+	}
+	double gt[6];
+	GetGeoTransform(gt);
+
+	// Pixel size of the full resolution, the finer axis decides so that the target is never undersampled
+	double res_x = std::sqrt(gt[1] * gt[1] + gt[4] * gt[4]);
+	double res_y = std::sqrt(gt[2] * gt[2] + gt[5] * gt[5]);
+	double resolution = std::min(res_x, res_y);
+
+	auto band = dataset->GetRasterBand(1);
+	int cols = dataset->GetRasterXSize();
+	int level = -1;
+	double level_resolution = resolution;
+
+	for (int i = 0; i < band->GetOverviewCount(); i++) {
+		auto overview = band->GetOverview(i);
+		if (overview == nullptr || overview->GetXSize() <= 0) {
+			continue;
+		}
+		double overview_resolution = resolution * cols / overview->GetXSize();
+
+		// Overviews are usually sorted from finer to coarser, but it is not guaranteed
+		if (overview_resolution <= target_resolution * (1.0 + 1e-6) && overview_resolution > level_resolution) {
+			level = i;
+			level_resolution = overview_resolution;
+		}
+	}
+	return level;
+}
+
+bool Raster::GetWindowOfExtent(double min_x, double min_y, double max_x, double max_y, RasterWindow &window) const {
+	double gt[6];
+	double inv_gt[6];
+	GetGeoTransform(gt);
+
+	if (!GDALInvGeoTransform(gt, inv_gt)) {
+		return false;
+	}
+
+	// Transform the corners of the extent, the geotransform can be rotated
+	double xs[4] = {min_x, max_x, max_x, min_x};
+	double ys[4] = {min_y, min_y, max_y, max_y};
+	double col_min = std::numeric_limits<double>::max();
+	double row_min = std::numeric_limits<double>::max();
+	double col_max = std::numeric_limits<double>::lowest();
+	double row_max = std::numeric_limits<double>::lowest();
+
+	for (int i = 0; i < 4; i++) {
+		double col = inv_gt[0] + xs[i] * inv_gt[1] + ys[i] * inv_gt[2];
+		double row = inv_gt[3] + xs[i] * inv_gt[4] + ys[i] * inv_gt[5];
+		col_min = std::min(col_min, col);
+		col_max = std::max(col_max, col);
+		row_min = std::min(row_min, row);
+		row_max = std::max(row_max, row);
+	}
+
+	auto x_off = std::max(0.0, std::floor(col_min));
+	auto y_off = std::max(0.0, std::floor(row_min));
+	auto x_end = std::min(static_cast<double>(dataset->GetRasterXSize()), std::ceil(col_max));
+	auto y_end = std::min(static_cast<double>(dataset->GetRasterYSize()), std::ceil(row_max));
+
+	if (x_end <= x_off || y_end <= y_off) {
+		return false;
+	}
+	window = RasterWindow(static_cast<int>(x_off), static_cast<int>(y_off), static_cast<int>(x_end - x_off),
+	                      static_cast<int>(y_end - y_off));
+	return true;
+}
+
+GDALDataset *Raster::GetWindow(const RasterWindow &window) const {
+	CPLStringList args;
+	args.AddString("-of");
+	args.AddString("VRT");
+	args.AddString("-srcwin");
+	args.AddString(std::to_string(window.x_off).c_str());
+	args.AddString(std::to_string(window.y_off).c_str());
+	args.AddString(std::to_string(window.x_size).c_str());
+	args.AddString(std::to_string(window.y_size).c_str());
+
+	auto options = GDALTranslateOptionsNew(args.List(), nullptr);
+	int usage_error = FALSE;
+	auto result = GDALTranslate("", GDALDataset::ToHandle(dataset), options, &usage_error);
+	GDALTranslateOptionsFree(options);
+
+	return GDALDataset::FromHandle(result);
+}
+
+GDALDataset *Raster::ClipByExtent(double min_x, double min_y, double max_x, double max_y) const {
+	RasterWindow window;
+
+	if (!GetWindowOfExtent(min_x, min_y, max_x, max_y, window)) {
+		return nullptr;
+	}
+	return GetWindow(window);
+}
+
+GDALDataset *Raster::ClipByGeometry(const OGRGeometry &geometry) const {
+	OGREnvelope env;
+	geometry.getEnvelope(&env);
+
+	auto cropped = ClipByExtent(env.MinX, env.MinY, env.MaxX, env.MaxY);
+	if (cropped == nullptr) {
+		return nullptr;
+	}
+
+	// Move the geometry to the pixel space of the cropped view, as expected by the cutline of the warper
+	double gt[6];
+	double inv_gt[6];
+	cropped->GetGeoTransform(gt);
+	GDALInvGeoTransform(gt, inv_gt);
+
+	auto cutline = geometry.clone();
+	GeoToPixelTransformation transformation(inv_gt);
+	cutline->transform(&transformation);
+
+	// Warp the cropped view into itself (same grid), so only the cutline is applied lazily on each block read
+	int band_count = cropped->GetRasterCount();
+	bool all_nodata = true;
+	bool use_alpha = false;
+	std::vector<double> nodata_values(band_count);
+	std::vector<bool> source_nodata(band_count);
+	std::vector<bool> has_nodata_values(band_count);
+
+	auto options = GDALCreateWarpOptions();
+	options->hSrcDS = GDALDataset::ToHandle(cropped);
+	options->nBandCount = band_count;
+	options->panSrcBands = static_cast<int *>(CPLMalloc(sizeof(int) * band_count));
+	options->panDstBands = static_cast<int *>(CPLMalloc(sizeof(int) * band_count));
+	options->padfSrcNoDataReal = static_cast<double *>(CPLMalloc(sizeof(double) * band_count));
+	options->padfDstNoDataReal = static_cast<double *>(CPLMalloc(sizeof(double) * band_count));
+
+	for (int i = 0; i < band_count; i++) {
+		auto band = cropped->GetRasterBand(i + 1);
+		int has_nodata = FALSE;
+		double nodata_value = band->GetNoDataValue(&has_nodata);
+		all_nodata &= has_nodata != FALSE;
+
+		options->panSrcBands[i] = i + 1;
+		options->panDstBands[i] = i + 1;
+		options->padfSrcNoDataReal[i] = has_nodata ? nodata_value : 0;
+		nodata_values[i] = nodata_value;
+		source_nodata[i] = has_nodata != FALSE;
+		has_nodata_values[i] = source_nodata[i];
+
+		// A NODATA value of 0 would mask valid pixels, floating point bands use NaN and other ones an alpha band
+		if (!has_nodata) {
+			has_nodata_values[i] = GetUnusedNoDataValue(band, nodata_values[i]);
+			use_alpha |= !has_nodata_values[i];
+		}
+		options->padfDstNoDataReal[i] = nodata_values[i];
+	}
+	if (!all_nodata) {
+		CPLFree(options->padfSrcNoDataReal);
+		options->padfSrcNoDataReal = nullptr;
+	}
+	if (use_alpha) {
+		// Some band has no NODATA value that cannot be a valid value, the pixels outside the geometry are masked by an
+		// alpha band
+		CPLFree(options->padfDstNoDataReal);
+		options->padfDstNoDataReal = nullptr;
+		options->nDstAlphaBand = band_count + 1;
+		has_nodata_values = source_nodata;
+	}
+	options->papszWarpOptions =
+	    CSLSetNameValue(options->papszWarpOptions, "INIT_DEST", use_alpha ? "0" : "NO_DATA");
+	options->hCutline = OGRGeometry::ToHandle(cutline);
+	options->pfnTransformer = GDALGenImgProjTransform;
+	options->pTransformerArg = GDALCreateGenImgProjTransformer2(options->hSrcDS, options->hSrcDS, nullptr);
+
+	auto warped = GDALCreateWarpedVRT(options->hSrcDS, cropped->GetRasterXSize(), cropped->GetRasterYSize(), gt,
+	                                  options);
+
+	// The warped VRT keeps its own copy of the options and takes ownership of the transformer
+	GDALDestroyWarpOptions(options);
+
+	if (warped == nullptr) {
+		GDALClose(GDALDataset::ToHandle(cropped));
+		return nullptr;
+	}
+
+	// The warped VRT holds a reference to the cropped view, release ours so it is closed along with it
+	cropped->Dereference();
+
+	auto result = GDALDataset::FromHandle(warped);
+	for (int i = 0; i < band_count; i++) {
+		if (has_nodata_values[i]) {
+			result->GetRasterBand(i + 1)->SetNoDataValue(nodata_values[i]);
+		}
+	}
+	return result;
+}
+
+GDALDataset *Raster::AlignTo(GDALDataset *reference, const std::string &resampling) const {
+	double gt[6];
+	Raster(reference).GetGeoTransform(gt);
+	auto cols = reference->GetRasterXSize();
+	auto rows = reference->GetRasterYSize();
+
+	CPLStringList args;
+	args.AddString("-of");
+	args.AddString("VRT");
+	args.AddString("-r");
+	args.AddString(resampling.c_str());
+	args.AddString("-ts");
+	args.AddString(std::to_string(cols).c_str());
+	args.AddString(std::to_string(rows).c_str());
+	args.AddString("-te");
+	args.AddString(CPLSPrintf("%.17g", std::min(gt[0], gt[0] + cols * gt[1])));
+	args.AddString(CPLSPrintf("%.17g", std::min(gt[3], gt[3] + rows * gt[5])));
+	args.AddString(CPLSPrintf("%.17g", std::max(gt[0], gt[0] + cols * gt[1])));
+	args.AddString(CPLSPrintf("%.17g", std::max(gt[3], gt[3] + rows * gt[5])));
+
+	// Without both coordinate systems, rasters are assumed to be in the same one
+	auto source_srs = dataset->GetSpatialRef();
+	auto target_srs = reference->GetSpatialRef();
+	char *target_wkt = nullptr;
+
+	if (source_srs && target_srs && target_srs->exportToWkt(&target_wkt) == OGRERR_NONE) {
+		args.AddString("-t_srs");
+		args.AddString(target_wkt);
+	}
+	CPLFree(target_wkt);
+
+	auto options = GDALWarpAppOptionsNew(args.List(), nullptr);
+	auto source = GDALDataset::ToHandle(dataset);
+	int usage_error = FALSE;
+	auto result = GDALWarp("", nullptr, 1, &source, options, &usage_error);
+	GDALWarpAppOptionsFree(options);
+
+	return GDALDataset::FromHandle(result);
+}
+
 std::string Raster::GetLastErrorMsg() {
 	return std::string(CPLGetLastErrorMsg());
 }
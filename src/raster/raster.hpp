@@ -1,15 +1,85 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
+class GDALDataset;
+class OGRGeometry;
+class OGRSpatialReference;
 
 namespace duckdb {
 
+//! A rectangular window of pixels of a Raster.
+struct RasterWindow {
+	int x_off;
+	int y_off;
+	int x_size;
+	int y_size;
+
+	RasterWindow() : x_off(0), y_off(0), x_size(0), y_size(0) {
+	}
+	explicit RasterWindow(int x_off, int y_off, int x_size, int y_size)
+	    : x_off(x_off), y_off(y_off), x_size(x_size), y_size(y_size) {
+	}
+};
+
 //! A wrapper of a GDALDataset with useful methods to manage raster data.
 //! Does not take ownership of the pointer.
 class Raster {
 public:
+	//! Constructor
+	explicit Raster(GDALDataset *dataset);
+
+	//! Returns the raster width in pixels
+	int GetRasterXSize() const;
+	//! Returns the raster height in pixels
+	int GetRasterYSize() const;
+	//! Returns the number of raster bands
+	int GetRasterCount() const;
+
+	//! Returns the geometric transform of the Raster, or the identity one if it is not georeferenced.
+	void GetGeoTransform(double gt[6]) const;
+
+	//! Returns the tiles covering the Raster, aligned with the natural block size of the band.
+	//! Blocks smaller than the minimum size are grouped to avoid too many tiny tiles.
+	std::vector<RasterWindow> GetTiles(int band_number = 1, int min_tile_size = 512) const;
+
+	//! Returns true if the Raster has the same grid (size, geotransform and coordinate system) as another Raster, so
+	//! their pixels can be combined one by one. Geotransforms are compared with a small tolerance relative to the pixel
+	//! size, and a Raster without coordinate system is assumed to be in the one of the other Raster.
+	bool HasSameGrid(GDALDataset *other) const;
+	//! Returns true if a coordinate system is the one of the Raster, a missing one on either side is assumed to match.
+	bool HasSameSpatialRef(const OGRSpatialReference *srs) const;
+
+	//! Returns the coarsest overview level whose pixel size is not larger than a target resolution (in the units of
+	//! the coordinate system of the Raster), or -1 when only the full resolution fits. Both internal and external
+	//! (.ovr) overviews are considered.
+	int GetOverviewLevel(double target_resolution) const;
+
+	//! Returns the window of pixels covering an extent (in the coordinate system of the Raster).
+	//! Returns false if the extent does not intersect the Raster.
+	bool GetWindowOfExtent(double min_x, double min_y, double max_x, double max_y, RasterWindow &window) const;
+
+	//! Returns a lazy view (VRT) of a window of the Raster, only intersecting blocks are read on demand.
+	GDALDataset *GetWindow(const RasterWindow &window) const;
+
+	//! Returns a lazy view of the Raster cropped to an extent, or nullptr if they do not intersect.
+	GDALDataset *ClipByExtent(double min_x, double min_y, double max_x, double max_y) const;
+	//! Returns a lazy view of the Raster cropped to the envelope of a geometry, where pixels outside the geometry
+	//! are NODATA, or nullptr if they do not intersect. The geometry must be in the coordinate system of the Raster.
+	//! Floating point bands without NODATA value get NaN, when another band has no NODATA value the pixels outside the
+	//! geometry are masked by an alpha band instead. Pixels are never read to choose a NODATA value.
+	GDALDataset *ClipByGeometry(const OGRGeometry &geometry) const;
+
+	//! Returns a lazy view (warped VRT) of the Raster resampled onto the grid (coordinate system, extent and size) of
+	//! a reference Raster, blocks are warped on demand when they are read.
+	GDALDataset *AlignTo(GDALDataset *reference, const std::string &resampling = "near") const;
+
 	//! Get the last error message.
 	static std::string GetLastErrorMsg();
+
+private:
+	GDALDataset *dataset;
 };
 
 } // namespace duckdb
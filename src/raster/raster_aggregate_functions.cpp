@@ -0,0 +1,727 @@
+#include "raster_types.hpp"
+#include "raster.hpp"
+#include "raster_aggregate_functions.hpp"
+
+// DuckDB
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/function/aggregate_function.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/extension_util.hpp"
+#include "duckdb/parser/parsed_data/create_aggregate_function_info.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+// GDAL
+#include "gdal_priv.h"
+#include "gdal_alg.h"
+#include "ogr_geometry.h"
+#include "ogr_spatialref.h"
+#include "gdal_dataset_factory.hpp"
+#include "gdal_context_state.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace duckdb {
+
+namespace {
+
+//======================================================================================================================
+// RT_Rasterize
+//======================================================================================================================
+
+//! Width of the tiles of the target grid. Each tile is a standard block of the BufferManager, so it is spilled to and
+//! reloaded from the shared temporary file like any other block: tiles have as many rows of 128 doubles as fit in the
+//! usable size of a block (255 rows with the default block size of 256 KiB, less its header).
+static constexpr int RASTERIZE_TILE_WIDTH = 128;
+//! Width and height of the blocks of the temporary GeoTIFF written for large grids
+static constexpr int RASTERIZE_FILE_BLOCK_SIZE = 256;
+
+//! Burns geometries into a RASTER of the given grid, merging the values of overlapping geometries.
+//!
+//! RT_Rasterize(geom, value, grid_spec [, mode])
+//!
+//! - geom: the geometry as WKB blob (e.g. `ST_AsWKB(geom)` of the spatial extension).
+//! - value: the value to burn.
+//! - grid_spec: a constant STRUCT with the `min_x`, `min_y`, `max_x`, `max_y`, `width` and `height` of the
+//!   target grid, and an optional `srs` (e.g. 'EPSG:4326').
+//! - mode: how values of a same pixel are merged, 'sum', 'max', 'last' (the default) or 'count'. With 'last', the
+//!   value of a pixel burnt by several geometries depends on the order in which the partial states are combined.
+//!
+//! Each thread accumulates into its own partial tiles, that are merged when the aggregate states are combined.
+//! Tiles are created on demand and managed by the BufferManager of DuckDB, so they are spilled to disk when the
+//! grid does not fit in memory.
+struct RT_Rasterize {
+
+	//! How the values burnt into a same pixel are merged
+	enum class MergeMode : uint8_t { SUM, MAX, LAST, COUNT };
+
+	//! Definition of the target grid
+	struct GridSpec {
+		double min_x;
+		double min_y;
+		double max_x;
+		double max_y;
+		int32_t width;
+		int32_t height;
+		string srs;
+
+		double ResolutionX() const {
+			return (max_x - min_x) / width;
+		}
+		double ResolutionY() const {
+			return (max_y - min_y) / height;
+		}
+		bool operator==(const GridSpec &other) const {
+			return min_x == other.min_x && min_y == other.min_y && max_x == other.max_x && max_y == other.max_y &&
+			       width == other.width && height == other.height && srs == other.srs;
+		}
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Merge
+	//------------------------------------------------------------------------------------------------------------------
+
+	static inline double EmptyValue(MergeMode mode) {
+		return mode == MergeMode::COUNT ? 0.0 : std::numeric_limits<double>::quiet_NaN();
+	}
+
+	//! Merges a burnt value into a pixel
+	static inline void MergeValue(MergeMode mode, double &cell, double value) {
+		switch (mode) {
+		case MergeMode::SUM:
+			cell = std::isnan(cell) ? value : cell + value;
+			break;
+		case MergeMode::MAX:
+			cell = std::isnan(cell) || value > cell ? value : cell;
+			break;
+		case MergeMode::LAST:
+			cell = value;
+			break;
+		case MergeMode::COUNT:
+			cell += 1;
+			break;
+		}
+	}
+
+	//! Merges the pixel of a partial tile into a pixel
+	static inline void CombineValue(MergeMode mode, double &cell, double partial) {
+		if (std::isnan(partial)) {
+			return;
+		}
+		switch (mode) {
+		case MergeMode::SUM:
+			cell = std::isnan(cell) ? partial : cell + partial;
+			break;
+		case MergeMode::MAX:
+			cell = std::isnan(cell) || partial > cell ? partial : cell;
+			break;
+		case MergeMode::LAST:
+			cell = partial;
+			break;
+		case MergeMode::COUNT:
+			cell += partial;
+			break;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Tiled Grid
+	//------------------------------------------------------------------------------------------------------------------
+
+	//! A tiled target grid of partial results, only tiles touched by some geometry are allocated.
+	class TiledGrid {
+	public:
+		TiledGrid(BufferManager &buffer_manager, const GridSpec &grid, MergeMode mode)
+		    : buffer_manager(buffer_manager), grid(grid), mode(mode) {
+			tile_bytes = buffer_manager.GetBlockSize();
+			tile_height = static_cast<int>(tile_bytes / (RASTERIZE_TILE_WIDTH * sizeof(double)));
+			tiles_x = (grid.width + RASTERIZE_TILE_WIDTH - 1) / RASTERIZE_TILE_WIDTH;
+		}
+
+		//! Burns a geometry (in the coordinate system of the grid) into the tiles it intersects
+		void Burn(const OGRGeometry &geometry, double value) {
+			if (geometry.IsEmpty()) {
+				return;
+			}
+			auto res_x = grid.ResolutionX();
+			auto res_y = grid.ResolutionY();
+
+			OGREnvelope env;
+			geometry.getEnvelope(&env);
+
+			auto col_min = static_cast<int64_t>(std::floor((env.MinX - grid.min_x) / res_x));
+			auto col_max = static_cast<int64_t>(std::floor((env.MaxX - grid.min_x) / res_x));
+			auto row_min = static_cast<int64_t>(std::floor((grid.max_y - env.MaxY) / res_y));
+			auto row_max = static_cast<int64_t>(std::floor((grid.max_y - env.MinY) / res_y));
+
+			if (col_max < 0 || row_max < 0 || col_min >= grid.width || row_min >= grid.height) {
+				return;
+			}
+			col_min = MaxValue<int64_t>(col_min, 0);
+			row_min = MaxValue<int64_t>(row_min, 0);
+			col_max = MinValue<int64_t>(col_max, grid.width - 1);
+			row_max = MinValue<int64_t>(row_max, grid.height - 1);
+
+			// Points touch one pixel, skip the rasterizer
+			if (wkbFlatten(geometry.getGeometryType()) == wkbPoint) {
+				auto tile_idx = (row_min / tile_height) * tiles_x + (col_min / RASTERIZE_TILE_WIDTH);
+				auto pixel_idx = (row_min % tile_height) * RASTERIZE_TILE_WIDTH + (col_min % RASTERIZE_TILE_WIDTH);
+				auto tile = GetTile(tile_idx);
+				auto data = reinterpret_cast<double *>(tile.Ptr());
+				MergeValue(mode, data[pixel_idx], value);
+				return;
+			}
+
+			for (auto tile_y = row_min / tile_height; tile_y <= row_max / tile_height; tile_y++) {
+				for (auto tile_x = col_min / RASTERIZE_TILE_WIDTH; tile_x <= col_max / RASTERIZE_TILE_WIDTH; tile_x++) {
+					auto x_off = MaxValue<int64_t>(col_min, tile_x * RASTERIZE_TILE_WIDTH);
+					auto y_off = MaxValue<int64_t>(row_min, tile_y * tile_height);
+					auto x_end = MinValue<int64_t>(col_max + 1, (tile_x + 1) * RASTERIZE_TILE_WIDTH);
+					auto y_end = MinValue<int64_t>(row_max + 1, (tile_y + 1) * tile_height);
+
+					RasterWindow window(static_cast<int>(x_off), static_cast<int>(y_off),
+					                    static_cast<int>(x_end - x_off), static_cast<int>(y_end - y_off));
+					BurnTile(geometry, value, tile_y * tiles_x + tile_x, window);
+				}
+			}
+		}
+
+		//! Merges the partial tiles of other grid into this one
+		void Combine(TiledGrid &other) {
+			for (auto &entry : other.tiles) {
+				auto target = tiles.find(entry.first);
+
+				// Tiles only touched by the other grid are just moved
+				if (target == tiles.end()) {
+					tiles[entry.first] = entry.second;
+					continue;
+				}
+				auto source_handle = buffer_manager.Pin(entry.second);
+				auto target_handle = buffer_manager.Pin(target->second);
+				auto source_data = reinterpret_cast<const double *>(source_handle.Ptr());
+				auto target_data = reinterpret_cast<double *>(target_handle.Ptr());
+
+				for (idx_t i = 0; i < static_cast<idx_t>(RASTERIZE_TILE_WIDTH) * tile_height; i++) {
+					CombineValue(mode, target_data[i], source_data[i]);
+				}
+			}
+			other.tiles.clear();
+		}
+
+		//! Writes the tiles into the first band of a dataset with the size of the grid
+		void WriteTo(GDALDataset *dataset) {
+			auto band = dataset->GetRasterBand(1);
+
+			for (auto &entry : tiles) {
+				auto tile_x = static_cast<int>(entry.first % tiles_x) * RASTERIZE_TILE_WIDTH;
+				auto tile_y = static_cast<int>(entry.first / tiles_x) * tile_height;
+				auto x_size = MinValue<int>(RASTERIZE_TILE_WIDTH, grid.width - tile_x);
+				auto y_size = MinValue<int>(tile_height, grid.height - tile_y);
+
+				auto handle = buffer_manager.Pin(entry.second);
+				if (band->RasterIO(GF_Write, tile_x, tile_y, x_size, y_size, handle.Ptr(), x_size, y_size,
+				                   GDT_Float64, sizeof(double), RASTERIZE_TILE_WIDTH * sizeof(double)) != CE_None) {
+					throw IOException("Could not write rasterized tile: " + Raster::GetLastErrorMsg());
+				}
+			}
+		}
+
+	private:
+		//! Pins a tile, creating it when it does not exist yet
+		BufferHandle GetTile(idx_t tile_idx) {
+			auto entry = tiles.find(tile_idx);
+			if (entry != tiles.end()) {
+				return buffer_manager.Pin(entry->second);
+			}
+			auto handle = buffer_manager.Allocate(MemoryTag::EXTENSION, tile_bytes, false);
+			auto data = reinterpret_cast<double *>(handle.Ptr());
+			std::fill_n(data, static_cast<idx_t>(RASTERIZE_TILE_WIDTH) * tile_height, EmptyValue(mode));
+			tiles[tile_idx] = handle.GetBlockHandle();
+			return handle;
+		}
+
+		//! Burns a geometry into a window of a tile, using the GDAL rasterizer over a scratch mask of the size of a
+		//! tile that is reused by all the geometries of the grid
+		void BurnTile(const OGRGeometry &geometry, double value, idx_t tile_idx, const RasterWindow &window) {
+			auto res_x = grid.ResolutionX();
+			auto res_y = grid.ResolutionY();
+
+			if (!mask) {
+				auto mem_driver = GetGDALDriverManager()->GetDriverByName("MEM");
+				mask = GDALDatasetUniquePtr(
+				    mem_driver->Create("", RASTERIZE_TILE_WIDTH, tile_height, 1, GDT_Byte, nullptr));
+				if (!mask) {
+					throw IOException("Could not create rasterized mask: " + Raster::GetLastErrorMsg());
+				}
+				mask_pixels.resize(static_cast<size_t>(RASTERIZE_TILE_WIDTH) * tile_height);
+			}
+			auto mask_band = mask->GetRasterBand(1);
+			auto x_off = window.x_off % RASTERIZE_TILE_WIDTH;
+			auto y_off = window.y_off % tile_height;
+
+			// The mask is placed over the tile, only the window of the geometry is cleared and read back
+			double mask_gt[6] = {grid.min_x + (window.x_off - x_off) * res_x, res_x, 0,
+			                     grid.max_y - (window.y_off - y_off) * res_y, 0, -res_y};
+			mask->SetGeoTransform(mask_gt);
+
+			std::fill_n(mask_pixels.data(), static_cast<size_t>(window.x_size) * window.y_size, 0);
+			if (mask_band->RasterIO(GF_Write, x_off, y_off, window.x_size, window.y_size, mask_pixels.data(),
+			                        window.x_size, window.y_size, GDT_Byte, 0, 0) != CE_None) {
+				throw IOException("Could not clear rasterized mask: " + Raster::GetLastErrorMsg());
+			}
+
+			int band_list[1] = {1};
+			double burn_values[1] = {1.0};
+			auto geometry_handle = OGRGeometry::ToHandle(const_cast<OGRGeometry *>(&geometry));
+
+			if (GDALRasterizeGeometries(GDALDataset::ToHandle(mask.get()), 1, band_list, 1, &geometry_handle, nullptr,
+			                            nullptr, burn_values, nullptr, nullptr, nullptr) != CE_None) {
+				throw IOException("Could not rasterize geometry: " + Raster::GetLastErrorMsg());
+			}
+
+			if (mask_band->RasterIO(GF_Read, x_off, y_off, window.x_size, window.y_size, mask_pixels.data(),
+			                        window.x_size, window.y_size, GDT_Byte, 0, 0) != CE_None) {
+				throw IOException("Could not read rasterized mask: " + Raster::GetLastErrorMsg());
+			}
+
+			auto tile = GetTile(tile_idx);
+			auto data = reinterpret_cast<double *>(tile.Ptr());
+
+			for (int y = 0; y < window.y_size; y++) {
+				auto mask_row = mask_pixels.data() + static_cast<size_t>(y) * window.x_size;
+				auto tile_row = data + static_cast<size_t>(y_off + y) * RASTERIZE_TILE_WIDTH + x_off;
+
+				for (int x = 0; x < window.x_size; x++) {
+					if (mask_row[x]) {
+						MergeValue(mode, tile_row[x], value);
+					}
+				}
+			}
+		}
+
+	private:
+		BufferManager &buffer_manager;
+		GridSpec grid;
+		MergeMode mode;
+		//! Size in bytes of a tile, the usable size of a standard block
+		idx_t tile_bytes;
+		int tile_height;
+		idx_t tiles_x;
+		//! Tiles of the grid by index, unpinned blocks can be evicted by the BufferManager
+		unordered_map<idx_t, shared_ptr<BlockHandle>> tiles;
+		//! Scratch mask where geometries are rasterized, created on first use
+		GDALDatasetUniquePtr mask;
+		vector<uint8_t> mask_pixels;
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Bind
+	//------------------------------------------------------------------------------------------------------------------
+
+	//! The grid and how values are merged. The client is only weakly referenced, as bind data can outlive it (e.g. in
+	//! a cached plan), its BufferManager and configuration are looked up when the states are updated and finalized.
+	struct BindData final : FunctionData {
+		weak_ptr<ClientContext> client;
+		GridSpec grid;
+		MergeMode mode;
+
+		explicit BindData(weak_ptr<ClientContext> client, const GridSpec &grid, MergeMode mode)
+		    : client(std::move(client)), grid(grid), mode(mode) {
+		}
+		unique_ptr<FunctionData> Copy() const override {
+			return make_uniq<BindData>(client, grid, mode);
+		}
+
+		shared_ptr<ClientContext> GetClient() const {
+			auto context = client.lock();
+			if (!context) {
+				throw InternalException("RT_Rasterize: the client of the query is no longer available");
+			}
+			return context;
+		}
+		bool Equals(const FunctionData &other_p) const override {
+			auto &other = other_p.Cast<BindData>();
+			return grid == other.grid && mode == other.mode;
+		}
+	};
+
+	static GridSpec ParseGridSpec(const Value &value) {
+		if (value.IsNull() || value.type().id() != LogicalTypeId::STRUCT) {
+			throw BinderException("RT_Rasterize: grid_spec must be a STRUCT with the extent and size of the grid");
+		}
+
+		GridSpec grid;
+		grid.min_x = grid.min_y = grid.max_x = grid.max_y = 0;
+		grid.width = grid.height = 0;
+
+		auto &child_types = StructType::GetChildTypes(value.type());
+		auto &children = StructValue::GetChildren(value);
+		idx_t required_fields = 0;
+
+		for (idx_t i = 0; i < children.size(); i++) {
+			auto name = StringUtil::Lower(child_types[i].first);
+			auto &child = children[i];
+
+			if (child.IsNull()) {
+				throw BinderException("RT_Rasterize: grid_spec field '%s' can not be NULL", name);
+			}
+			if (name == "min_x") {
+				grid.min_x = child.GetValue<double>();
+			} else if (name == "min_y") {
+				grid.min_y = child.GetValue<double>();
+			} else if (name == "max_x") {
+				grid.max_x = child.GetValue<double>();
+			} else if (name == "max_y") {
+				grid.max_y = child.GetValue<double>();
+			} else if (name == "width") {
+				grid.width = child.GetValue<int32_t>();
+			} else if (name == "height") {
+				grid.height = child.GetValue<int32_t>();
+			} else if (name == "srs") {
+				grid.srs = child.GetValue<string>();
+				continue;
+			} else {
+				throw BinderException("RT_Rasterize: unknown grid_spec field '%s'", name);
+			}
+			required_fields++;
+		}
+
+		if (required_fields != 6) {
+			throw BinderException(
+			    "RT_Rasterize: grid_spec requires the 'min_x', 'min_y', 'max_x', 'max_y', 'width' and 'height' fields");
+		}
+		if (grid.width <= 0 || grid.height <= 0 || grid.max_x <= grid.min_x || grid.max_y <= grid.min_y) {
+			throw BinderException("RT_Rasterize: grid_spec defines an empty grid");
+		}
+		return grid;
+	}
+
+	static MergeMode ParseMergeMode(const Value &value) {
+		auto mode = StringUtil::Lower(value.ToString());
+
+		if (mode == "sum") {
+			return MergeMode::SUM;
+		} else if (mode == "max") {
+			return MergeMode::MAX;
+		} else if (mode == "last") {
+			return MergeMode::LAST;
+		} else if (mode == "count") {
+			return MergeMode::COUNT;
+		}
+		throw BinderException("RT_Rasterize: unknown mode '%s', expected 'sum', 'max', 'last' or 'count'", mode);
+	}
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, AggregateFunction &function,
+	                                     vector<unique_ptr<Expression>> &arguments) {
+		if (!arguments[2]->IsFoldable()) {
+			throw BinderException("RT_Rasterize: grid_spec must be a constant");
+		}
+		auto grid = ParseGridSpec(ExpressionExecutor::EvaluateScalar(context, *arguments[2]));
+
+		auto mode = MergeMode::LAST;
+		if (arguments.size() > 3) {
+			if (!arguments[3]->IsFoldable()) {
+				throw BinderException("RT_Rasterize: mode must be a constant");
+			}
+			auto mode_value = ExpressionExecutor::EvaluateScalar(context, *arguments[3]);
+			if (!mode_value.IsNull()) {
+				mode = ParseMergeMode(mode_value);
+			}
+		}
+
+		function.arguments[2] = arguments[2]->return_type;
+		return make_uniq<BindData>(context.shared_from_this(), grid, mode);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// State
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct State {
+		TiledGrid *grid;
+	};
+
+	static idx_t StateSize(const AggregateFunction &) {
+		return sizeof(State);
+	}
+
+	static void Initialize(const AggregateFunction &, data_ptr_t state_p) {
+		auto state = reinterpret_cast<State *>(state_p);
+		state->grid = nullptr;
+	}
+
+	static void Destroy(Vector &state_vector, AggregateInputData &, idx_t count) {
+		auto states = FlatVector::GetData<State *>(state_vector);
+		for (idx_t i = 0; i < count; i++) {
+			delete states[i]->grid;
+			states[i]->grid = nullptr;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Update
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void BurnRow(State &state, const BindData &bind_data, const string_t &wkb, double value) {
+		if (!state.grid) {
+			auto &buffer_manager = BufferManager::GetBufferManager(*bind_data.GetClient());
+			state.grid = new TiledGrid(buffer_manager, bind_data.grid, bind_data.mode);
+		}
+
+		OGRGeometry *geometry = nullptr;
+		if (OGRGeometryFactory::createFromWkb(wkb.GetData(), nullptr, &geometry, wkb.GetSize()) != OGRERR_NONE) {
+			throw InvalidInputException("RT_Rasterize: invalid WKB geometry");
+		}
+		unique_ptr<OGRGeometry> geometry_ptr(geometry);
+		state.grid->Burn(*geometry, value);
+	}
+
+	static void Update(Vector inputs[], AggregateInputData &aggr_input_data, idx_t input_count,
+	                   Vector &state_vector, idx_t count) {
+		auto &bind_data = aggr_input_data.bind_data->Cast<BindData>();
+
+		UnifiedVectorFormat geom_format;
+		UnifiedVectorFormat value_format;
+		UnifiedVectorFormat state_format;
+		inputs[0].ToUnifiedFormat(count, geom_format);
+		inputs[1].ToUnifiedFormat(count, value_format);
+		state_vector.ToUnifiedFormat(count, state_format);
+
+		auto geom_data = UnifiedVectorFormat::GetData<string_t>(geom_format);
+		auto value_data = UnifiedVectorFormat::GetData<double>(value_format);
+		auto states = UnifiedVectorFormat::GetData<State *>(state_format);
+		auto count_mode = bind_data.mode == MergeMode::COUNT;
+
+		for (idx_t i = 0; i < count; i++) {
+			auto geom_idx = geom_format.sel->get_index(i);
+			auto value_idx = value_format.sel->get_index(i);
+
+			if (!geom_format.validity.RowIsValid(geom_idx)) {
+				continue;
+			}
+			if (!count_mode && !value_format.validity.RowIsValid(value_idx)) {
+				continue;
+			}
+			auto value = count_mode ? 1.0 : value_data[value_idx];
+			BurnRow(*states[state_format.sel->get_index(i)], bind_data, geom_data[geom_idx], value);
+		}
+	}
+
+	static void SimpleUpdate(Vector inputs[], AggregateInputData &aggr_input_data, idx_t input_count,
+	                         data_ptr_t state_p, idx_t count) {
+		Vector state_vector(Value::POINTER(CastPointerToValue(state_p)));
+		Update(inputs, aggr_input_data, input_count, state_vector, count);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Combine
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void Combine(Vector &source_vector, Vector &target_vector, AggregateInputData &, idx_t count) {
+		UnifiedVectorFormat source_format;
+		source_vector.ToUnifiedFormat(count, source_format);
+
+		auto sources = UnifiedVectorFormat::GetData<State *>(source_format);
+		auto targets = FlatVector::GetData<State *>(target_vector);
+
+		for (idx_t i = 0; i < count; i++) {
+			auto &source = *sources[source_format.sel->get_index(i)];
+			auto &target = *targets[i];
+
+			if (!source.grid) {
+				continue;
+			}
+			if (!target.grid) {
+				target.grid = source.grid;
+				source.grid = nullptr;
+				continue;
+			}
+			target.grid->Combine(*source.grid);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Finalize
+	//------------------------------------------------------------------------------------------------------------------
+
+	//! Creates the output dataset, in memory when it is small enough, otherwise as a sparse tiled GeoTIFF in the
+	//! temporary directory of DuckDB to keep memory usage bounded.
+	static GDALDataset *CreateDataset(ClientContext &context, const BindData &bind_data, string &temp_file_path) {
+		auto &grid = bind_data.grid;
+
+		auto &buffer_manager = BufferManager::GetBufferManager(context);
+		auto &temp_directory = DBConfig::GetConfig(context).options.temporary_directory;
+		auto raster_bytes = static_cast<idx_t>(grid.width) * grid.height * sizeof(double);
+		auto in_memory = temp_directory.empty() || raster_bytes <= buffer_manager.GetMaxMemory() / 4;
+
+		GDALDataset *dataset;
+
+		if (in_memory) {
+			auto driver = GetGDALDriverManager()->GetDriverByName("MEM");
+			dataset = driver->Create("", grid.width, grid.height, 1, GDT_Float64, nullptr);
+		} else {
+			auto &fs = FileSystem::GetFileSystem(context);
+			if (!fs.DirectoryExists(temp_directory)) {
+				fs.CreateDirectory(temp_directory);
+			}
+			temp_file_path =
+			    fs.JoinPath(temp_directory, "rt_rasterize_" + UUID::ToString(UUID::GenerateRandomUUID()) + ".tif");
+
+			auto block_size = std::to_string(RASTERIZE_FILE_BLOCK_SIZE);
+			auto write_options = vector<string> {"TILED=YES",
+			                                     "BLOCKXSIZE=" + block_size,
+			                                     "BLOCKYSIZE=" + block_size,
+			                                     "SPARSE_OK=TRUE",
+			                                     "COMPRESS=DEFLATE",
+			                                     "BIGTIFF=IF_SAFER"};
+			auto gdal_write_options = GDALDatasetFactory::FromVectorOfStrings(write_options);
+
+			auto driver = GetGDALDriverManager()->GetDriverByName("GTiff");
+			dataset = driver->Create(temp_file_path.c_str(), grid.width, grid.height, 1, GDT_Float64,
+			                         const_cast<char **>(gdal_write_options.data()));
+		}
+		if (dataset == nullptr) {
+			throw IOException("Could not create rasterized dataset: " + Raster::GetLastErrorMsg());
+		}
+
+		double gt[6] = {grid.min_x, grid.ResolutionX(), 0, grid.max_y, 0, -grid.ResolutionY()};
+		dataset->SetGeoTransform(gt);
+
+		if (!grid.srs.empty()) {
+			OGRSpatialReference srs;
+			if (srs.SetFromUserInput(grid.srs.c_str()) != OGRERR_NONE) {
+				GDALClose(GDALDataset::ToHandle(dataset));
+				throw InvalidInputException("RT_Rasterize: invalid srs '%s'", grid.srs);
+			}
+			dataset->SetSpatialRef(&srs);
+		}
+
+		// Pixels not touched by any geometry are NODATA, except when counting
+		if (bind_data.mode != MergeMode::COUNT) {
+			auto band = dataset->GetRasterBand(1);
+			band->SetNoDataValue(EmptyValue(bind_data.mode));
+			if (in_memory) {
+				band->Fill(EmptyValue(bind_data.mode));
+			}
+		}
+		return dataset;
+	}
+
+	static void FinalizeState(const BindData &bind_data, State &state, Vector &result, idx_t result_idx) {
+		if (!state.grid) {
+			if (result.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+				ConstantVector::SetNull(result, true);
+			} else {
+				FlatVector::SetNull(result, result_idx, true);
+			}
+			return;
+		}
+
+		auto context = bind_data.GetClient();
+		string temp_file_path;
+		auto dataset = CreateDataset(*context, bind_data, temp_file_path);
+
+		auto &ctx_state = GDALClientContextState::GetOrCreate(*context);
+		if (temp_file_path.empty()) {
+			ctx_state.GetDatasetRegistry(*context).RegisterDataset(dataset);
+		} else {
+			ctx_state.GetDatasetRegistry(*context).RegisterTemporaryDataset(dataset, temp_file_path);
+		}
+		state.grid->WriteTo(dataset);
+		dataset->FlushCache();
+
+		auto result_data = reinterpret_cast<uintptr_t *>(result.GetData());
+		result_data[result_idx] = CastPointerToValue(dataset);
+	}
+
+	static void Finalize(Vector &state_vector, AggregateInputData &aggr_input_data, Vector &result, idx_t count,
+	                     idx_t offset) {
+		auto &bind_data = aggr_input_data.bind_data->Cast<BindData>();
+
+		if (state_vector.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+			result.SetVectorType(VectorType::CONSTANT_VECTOR);
+			auto state = ConstantVector::GetData<State *>(state_vector)[0];
+			FinalizeState(bind_data, *state, result, 0);
+		} else {
+			result.SetVectorType(VectorType::FLAT_VECTOR);
+			auto states = FlatVector::GetData<State *>(state_vector);
+			for (idx_t i = 0; i < count; i++) {
+				FinalizeState(bind_data, *states[i], result, i + offset);
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Documentation
+	//------------------------------------------------------------------------------------------------------------------
+
+	static constexpr auto DOCUMENTATION = R"(
+	    Burns geometries into a new raster, as an aggregate of (geometry, value) pairs.
+
+	    The target grid is given by a STRUCT with the extent and the size in pixels of the raster, and optionally its coordinate system.
+	    The grid is split into square tiles of 128x128 pixels that are filled in parallel and merged by the `mode` parameter.
+
+	    | Parameter | Type | Description |
+	    | --------- | -----| ----------- |
+	    | `geometry` | BLOB | The geometry to burn as WKB. Mandatory |
+	    | `value` | DOUBLE | The value burnt into the pixels covered by the geometry. Mandatory |
+	    | `grid` | STRUCT | The target grid: `min_x`, `min_y`, `max_x`, `max_y`, `width` and `height`, and optionally `srs`. Must be a constant. Mandatory |
+	    | `mode` | VARCHAR | How values burnt into a same pixel are merged: `sum`, `max`, `count` or `last` (the default). Must be a constant. |
+
+	    A pixel is burnt when its center is inside the geometry. Pixels not burnt by any geometry are NODATA, except with `count` where they are zero.
+
+	    With `last`, the value of a pixel burnt by several geometries depends on the order in which the rows are read and the partial results of the threads are merged, so it is not deterministic. Use `max` or `sum` when geometries overlap and a reproducible raster is needed.
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		-- Rasterize the population of districts into a 100m grid
+		SELECT RT_Rasterize(
+		    geom_wkb,
+		    population,
+		    {'min_x': 500000, 'min_y': 4000000, 'max_x': 600000, 'max_y': 4100000, 'width': 1000, 'height': 1000, 'srs': 'EPSG:32630'},
+		    'sum'
+		) AS raster
+		FROM districts;
+	)";
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Register
+	//------------------------------------------------------------------------------------------------------------------
+
+	static AggregateFunction GetFunction(const vector<LogicalType> &arguments) {
+		return AggregateFunction("RT_Rasterize", arguments, RasterTypes::RASTER(), StateSize, Initialize, Update,
+		                         Combine, Finalize, FunctionNullHandling::DEFAULT_NULL_HANDLING, SimpleUpdate, Bind,
+		                         Destroy);
+	}
+
+	static void Register(DatabaseInstance &db) {
+		AggregateFunctionSet set("RT_Rasterize");
+		set.AddFunction(GetFunction({LogicalType::BLOB, LogicalType::DOUBLE, LogicalType::ANY}));
+		set.AddFunction(GetFunction({LogicalType::BLOB, LogicalType::DOUBLE, LogicalType::ANY, LogicalType::VARCHAR}));
+
+		CreateAggregateFunctionInfo info(std::move(set));
+		FunctionDescription description;
+		description.description = DOCUMENTATION;
+		description.examples.push_back(EXAMPLE);
+		info.descriptions.push_back(std::move(description));
+		info.tags["ext"] = "spatial_raster";
+		info.tags["category"] = "aggregation";
+		ExtensionUtil::RegisterFunction(db, std::move(info));
+	}
+};
+
+} // namespace
+
+// ######################################################################################################################
+//  Register Raster Aggregate Functions
+// ######################################################################################################################
+
+void GdalRasterAggregateFunctions::Register(DatabaseInstance &db) {
+
+	// Register functions
+	RT_Rasterize::Register(db);
+}
+
+} // namespace duckdb
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace duckdb {
+
+class DatabaseInstance;
+
+struct GdalRasterAggregateFunctions {
+public:
+	static void Register(DatabaseInstance &db);
+};
+
+} // namespace duckdb
@@ -0,0 +1,313 @@
+#include "raster_focal.hpp"
+#include "raster.hpp"
+#include "raster_tile_executor.hpp"
+#include "gdal_dataset_factory.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+// GDAL
+#include "gdal_priv.h"
+
+#include <cmath>
+#include <limits>
+
+namespace duckdb {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr float DEG_TO_RAD = static_cast<float>(PI / 180.0);
+constexpr float RAD_TO_DEG = static_cast<float>(180.0 / PI);
+
+//! Number of pixels of a row whose gradients are computed at once, the gradients of a chunk stay in the L1 cache
+//! between the gradient pass and the pass that derives the output values from them
+constexpr int GRADIENT_CHUNK_SIZE = 256;
+
+//! Horn's gradients of the pixels [x0, x0 + count) of a row, the 3x3 window of a pixel is:
+//!   a b c  <- r0
+//!   d e f  <- r1
+//!   g h i  <- r2
+//! The center pixel 'e' is not used but it is added with a zero weight to propagate NODATA (NaN).
+//! The loop only has multiply-adds over contiguous arrays, so it is auto-vectorized.
+inline void HornGradients(const float *r0, const float *r1, const float *r2, int x0, int count, float scale_x,
+                          float scale_y, float *dzdx, float *dzdy) {
+	r0 += x0;
+	r1 += x0;
+	r2 += x0;
+	for (int i = 0; i < count; i++) {
+		dzdx[i] = ((r0[i + 2] + 2 * r1[i + 2] + r2[i + 2]) - (r0[i] + 2 * r1[i] + r2[i])) * scale_x + r1[i + 1] * 0.0f;
+		dzdy[i] = ((r2[i] + 2 * r2[i + 1] + r2[i + 2]) - (r0[i] + 2 * r0[i + 1] + r0[i + 2])) * scale_y;
+	}
+}
+
+} // namespace
+
+//======================================================================================================================
+// Kernels
+//======================================================================================================================
+
+RasterSlopeKernel::RasterSlopeKernel(double res_x, double res_y, double z_factor)
+    : scale_x(static_cast<float>(z_factor / (8.0 * res_x))), scale_y(static_cast<float>(z_factor / (8.0 * res_y))) {
+}
+
+void RasterSlopeKernel::ComputeRow(const float *const *rows, float *output, int width) const {
+	float dzdx[GRADIENT_CHUNK_SIZE];
+	float dzdy[GRADIENT_CHUNK_SIZE];
+
+	for (int x0 = 0; x0 < width; x0 += GRADIENT_CHUNK_SIZE) {
+		const int count = MinValue<int>(GRADIENT_CHUNK_SIZE, width - x0);
+		HornGradients(rows[0], rows[1], rows[2], x0, count, scale_x, scale_y, dzdx, dzdy);
+
+		// The arc tangent is a libm call that the compiler does not vectorize, it is kept out of the gradient loop
+		for (int i = 0; i < count; i++) {
+			output[x0 + i] = std::atan(std::sqrt(dzdx[i] * dzdx[i] + dzdy[i] * dzdy[i])) * RAD_TO_DEG;
+		}
+	}
+}
+
+RasterAspectKernel::RasterAspectKernel() {
+}
+
+void RasterAspectKernel::ComputeRow(const float *const *rows, float *output, int width) const {
+	const float nan_value = std::numeric_limits<float>::quiet_NaN();
+	float dzdx[GRADIENT_CHUNK_SIZE];
+	float dzdy[GRADIENT_CHUNK_SIZE];
+
+	for (int x0 = 0; x0 < width; x0 += GRADIENT_CHUNK_SIZE) {
+		const int count = MinValue<int>(GRADIENT_CHUNK_SIZE, width - x0);
+		HornGradients(rows[0], rows[1], rows[2], x0, count, 1.0f, 1.0f, dzdx, dzdy);
+
+		for (int i = 0; i < count; i++) {
+			// Convert the math angle to a compass bearing
+			float aspect = std::atan2(dzdy[i], -dzdx[i]) * RAD_TO_DEG;
+			aspect = aspect < 0 ? 90.0f - aspect : (aspect > 90.0f ? 450.0f - aspect : 90.0f - aspect);
+			output[x0 + i] = (dzdx[i] == 0 && dzdy[i] == 0) ? nan_value : aspect;
+		}
+	}
+}
+
+RasterHillshadeKernel::RasterHillshadeKernel(double res_x, double res_y, double z_factor, double azimuth,
+                                             double altitude)
+    : scale_x(static_cast<float>(z_factor / (8.0 * res_x))), scale_y(static_cast<float>(z_factor / (8.0 * res_y))) {
+	auto zenith = static_cast<float>(90.0 - altitude) * DEG_TO_RAD;
+	auto azimuth_rad = static_cast<float>(std::fmod(360.0 - azimuth + 90.0, 360.0)) * DEG_TO_RAD;
+	zenith_cos = std::cos(zenith);
+	zenith_sin = std::sin(zenith);
+	azimuth_cos = std::cos(azimuth_rad);
+	azimuth_sin = std::sin(azimuth_rad);
+}
+
+void RasterHillshadeKernel::ComputeRow(const float *const *rows, float *output, int width) const {
+	float dzdx[GRADIENT_CHUNK_SIZE];
+	float dzdy[GRADIENT_CHUNK_SIZE];
+
+	for (int x0 = 0; x0 < width; x0 += GRADIENT_CHUNK_SIZE) {
+		const int count = MinValue<int>(GRADIENT_CHUNK_SIZE, width - x0);
+		HornGradients(rows[0], rows[1], rows[2], x0, count, scale_x, scale_y, dzdx, dzdy);
+
+		// cos(zenith) * cos(slope) + sin(zenith) * sin(slope) * cos(azimuth - aspect), with the slope and the aspect
+		// expanded from the gradients, so the loop only has a square root and a division and is vectorized as well
+		for (int i = 0; i < count; i++) {
+			float shade = 255.0f * (zenith_cos + zenith_sin * (dzdy[i] * azimuth_sin - dzdx[i] * azimuth_cos)) /
+			              std::sqrt(1.0f + dzdx[i] * dzdx[i] + dzdy[i] * dzdy[i]);
+			output[x0 + i] = shade < 0 ? 0.0f : shade;
+		}
+	}
+}
+
+RasterConvolutionKernel::RasterConvolutionKernel(const vector<float> &weights, int size)
+    : weights(weights), size(size) {
+}
+
+void RasterConvolutionKernel::ComputeRow(const float *const *rows, float *output, int width) const {
+	std::fill(output, output + width, 0.0f);
+
+	// Accumulate one weight at a time over the full row, so the inner loop is a plain multiply-add
+	for (int ky = 0; ky < size; ky++) {
+		const float *row = rows[ky];
+
+		for (int kx = 0; kx < size; kx++) {
+			const float weight = weights[ky * size + kx];
+			const float *input = row + kx;
+
+			for (int x = 0; x < width; x++) {
+				output[x] += weight * input[x];
+			}
+		}
+	}
+}
+
+//======================================================================================================================
+// RasterFocal
+//======================================================================================================================
+
+namespace {
+
+//! Width and height of the blocks of the temporary GeoTIFF written for large outputs
+constexpr int FOCAL_FILE_BLOCK_SIZE = 256;
+
+//! Creates the output dataset, in memory when it is small enough, otherwise as a tiled GeoTIFF in the temporary
+//! directory of DuckDB to keep memory usage bounded.
+GDALDataset *CreateOutputDataset(ClientContext &context, int cols, int rows, int band_count, string &temp_file_path) {
+	auto &buffer_manager = BufferManager::GetBufferManager(context);
+	auto &temp_directory = DBConfig::GetConfig(context).options.temporary_directory;
+	auto raster_bytes = static_cast<idx_t>(cols) * rows * band_count * sizeof(float);
+	auto in_memory = temp_directory.empty() || raster_bytes <= buffer_manager.GetMaxMemory() / 4;
+
+	GDALDataset *dataset;
+
+	if (in_memory) {
+		auto driver = GetGDALDriverManager()->GetDriverByName("MEM");
+		dataset = driver->Create("", cols, rows, band_count, GDT_Float32, nullptr);
+	} else {
+		auto &fs = FileSystem::GetFileSystem(context);
+		if (!fs.DirectoryExists(temp_directory)) {
+			fs.CreateDirectory(temp_directory);
+		}
+		temp_file_path = fs.JoinPath(temp_directory, "rt_focal_" + UUID::ToString(UUID::GenerateRandomUUID()) + ".tif");
+
+		auto block_size = std::to_string(FOCAL_FILE_BLOCK_SIZE);
+		auto write_options = vector<string> {"TILED=YES",
+		                                     "BLOCKXSIZE=" + block_size,
+		                                     "BLOCKYSIZE=" + block_size,
+		                                     "COMPRESS=DEFLATE",
+		                                     "INTERLEAVE=BAND",
+		                                     "BIGTIFF=IF_SAFER"};
+		auto gdal_write_options = GDALDatasetFactory::FromVectorOfStrings(write_options);
+
+		auto driver = GetGDALDriverManager()->GetDriverByName("GTiff");
+		dataset = driver->Create(temp_file_path.c_str(), cols, rows, band_count, GDT_Float32,
+		                         const_cast<char **>(gdal_write_options.data()));
+	}
+	if (dataset == nullptr) {
+		throw IOException("Could not create output raster: " + Raster::GetLastErrorMsg());
+	}
+	return dataset;
+}
+
+//! Reads a tile extended with a halo, replicating the borders of the Raster when the halo falls outside of it
+void ReadTileWithHalo(RasterTileReader &reader, int band_number, const RasterWindow &tile, int halo, int cols,
+                      int rows, bool has_nodata, float nodata_value, vector<float> &input) {
+	int x0 = MaxValue<int>(0, tile.x_off - halo);
+	int y0 = MaxValue<int>(0, tile.y_off - halo);
+	int x1 = MinValue<int>(cols, tile.x_off + tile.x_size + halo);
+	int y1 = MinValue<int>(rows, tile.y_off + tile.y_size + halo);
+	int window_x_size = x1 - x0;
+	int window_y_size = y1 - y0;
+
+	vector<float> window_data(static_cast<size_t>(window_x_size) * window_y_size);
+	reader.Read(band_number, RasterWindow(x0, y0, window_x_size, window_y_size), GDT_Float32, window_data.data(),
+	            window_x_size, window_y_size);
+
+	if (has_nodata) {
+		const float nan_value = std::numeric_limits<float>::quiet_NaN();
+		for (auto &value : window_data) {
+			value = value == nodata_value ? nan_value : value;
+		}
+	}
+
+	int padded_x_size = tile.x_size + 2 * halo;
+	int padded_y_size = tile.y_size + 2 * halo;
+	int left_pad = x0 - (tile.x_off - halo);
+	int right_pad = (tile.x_off + tile.x_size + halo) - x1;
+
+	input.resize(static_cast<size_t>(padded_x_size) * padded_y_size);
+
+	for (int py = 0; py < padded_y_size; py++) {
+		int sy = MinValue<int>(MaxValue<int>(tile.y_off - halo + py, y0), y1 - 1) - y0;
+		const float *source = window_data.data() + static_cast<size_t>(sy) * window_x_size;
+		float *target = input.data() + static_cast<size_t>(py) * padded_x_size;
+
+		std::fill(target, target + left_pad, source[0]);
+		std::copy(source, source + window_x_size, target + left_pad);
+		std::fill(target + left_pad + window_x_size, target + left_pad + window_x_size + right_pad,
+		          source[window_x_size - 1]);
+	}
+}
+
+} // namespace
+
+GDALDataset *RasterFocal::Execute(ClientContext &context, GDALDataset *dataset, const vector<int> &band_numbers,
+                                  const RasterFocalKernel &kernel, string &temp_file_path) {
+	Raster raster(dataset);
+	auto cols = raster.GetRasterXSize();
+	auto rows = raster.GetRasterYSize();
+	auto band_count = static_cast<int>(band_numbers.size());
+	auto halo = kernel.GetHalo();
+
+	vector<bool> has_nodata(band_count);
+	vector<float> nodata_values(band_count);
+
+	for (int i = 0; i < band_count; i++) {
+		if (band_numbers[i] < 1 || band_numbers[i] > dataset->GetRasterCount()) {
+			throw InvalidInputException("Band %d out of range, the raster has %d bands", band_numbers[i],
+			                            dataset->GetRasterCount());
+		}
+		int band_has_nodata = FALSE;
+		auto nodata_value = dataset->GetRasterBand(band_numbers[i])->GetNoDataValue(&band_has_nodata);
+		has_nodata[i] = band_has_nodata != FALSE;
+		nodata_values[i] = static_cast<float>(nodata_value);
+	}
+
+	// Output dataset
+	auto output = GDALDatasetUniquePtr(CreateOutputDataset(context, cols, rows, band_count, temp_file_path));
+
+	double gt[6];
+	raster.GetGeoTransform(gt);
+	output->SetGeoTransform(gt);
+	output->SetSpatialRef(dataset->GetSpatialRef());
+
+	for (int i = 0; i < band_count; i++) {
+		output->GetRasterBand(i + 1)->SetNoDataValue(std::numeric_limits<double>::quiet_NaN());
+	}
+
+	// Process all tiles of all bands in parallel
+	auto tiles = raster.GetTiles(band_numbers[0]);
+	auto tile_count = tiles.size();
+	RasterTileExecutor executor(context, dataset);
+
+	try {
+		executor.Execute(tile_count * band_count, [&](RasterTileReader &reader, idx_t task_idx) {
+			auto &tile = tiles[task_idx % tile_count];
+			auto band_idx = static_cast<int>(task_idx / tile_count);
+			auto padded_x_size = tile.x_size + 2 * halo;
+
+			vector<float> input;
+			ReadTileWithHalo(reader, band_numbers[band_idx], tile, halo, cols, rows, has_nodata[band_idx],
+			                 nodata_values[band_idx], input);
+
+			vector<float> result(static_cast<size_t>(tile.x_size) * tile.y_size);
+			vector<const float *> input_rows(2 * halo + 1);
+
+			for (int y = 0; y < tile.y_size; y++) {
+				for (int k = 0; k < 2 * halo + 1; k++) {
+					input_rows[k] = input.data() + static_cast<size_t>(y + k) * padded_x_size;
+				}
+				auto output_row = result.data() + static_cast<size_t>(y) * tile.x_size;
+				kernel.ComputeRow(input_rows.data(), output_row, tile.x_size);
+			}
+
+			lock_guard<mutex> guard(executor.GetWriteLock());
+			auto band = output->GetRasterBand(band_idx + 1);
+			if (band->RasterIO(GF_Write, tile.x_off, tile.y_off, tile.x_size, tile.y_size, result.data(),
+			                   tile.x_size, tile.y_size, GDT_Float32, 0, 0) != CE_None) {
+				throw IOException("Could not write output tile: " + Raster::GetLastErrorMsg());
+			}
+		});
+	} catch (...) {
+		// Do not leave the temporary file behind, the caller only releases it with the returned dataset
+		output.reset();
+		if (!temp_file_path.empty()) {
+			VSIUnlink(temp_file_path.c_str());
+			temp_file_path.clear();
+		}
+		throw;
+	}
+	output->FlushCache();
+
+	return output.release();
+}
+
+} // namespace duckdb
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+class GDALDataset;
+
+namespace duckdb {
+
+class ClientContext;
+
+//! A neighborhood operation, it computes the output pixels of a tile from the input pixels of the tile extended
+//! with a halo of pixels on each side. NODATA pixels are NaN in both the input and the output buffers.
+class RasterFocalKernel {
+public:
+	virtual ~RasterFocalKernel() {
+	}
+
+	//! Returns the number of pixels of the halo required on each side of a tile
+	virtual int GetHalo() const = 0;
+
+	//! Computes a row of output pixels, 'rows' points to the 2 * halo + 1 input rows centered on the output row,
+	//! every input row starts 'halo' pixels before the first output pixel.
+	virtual void ComputeRow(const float *const *rows, float *output, int width) const = 0;
+};
+
+//! Slope in degrees, using the Horn's method over a 3x3 window.
+class RasterSlopeKernel final : public RasterFocalKernel {
+public:
+	RasterSlopeKernel(double res_x, double res_y, double z_factor);
+
+	int GetHalo() const override {
+		return 1;
+	}
+	void ComputeRow(const float *const *rows, float *output, int width) const override;
+
+private:
+	float scale_x;
+	float scale_y;
+};
+
+//! Aspect in degrees clockwise from north, using the Horn's method over a 3x3 window. Flat areas are NODATA.
+class RasterAspectKernel final : public RasterFocalKernel {
+public:
+	RasterAspectKernel();
+
+	int GetHalo() const override {
+		return 1;
+	}
+	void ComputeRow(const float *const *rows, float *output, int width) const override;
+};
+
+//! Shaded relief in [0, 255] for a light source at the given azimuth and altitude (in degrees).
+class RasterHillshadeKernel final : public RasterFocalKernel {
+public:
+	RasterHillshadeKernel(double res_x, double res_y, double z_factor, double azimuth, double altitude);
+
+	int GetHalo() const override {
+		return 1;
+	}
+	void ComputeRow(const float *const *rows, float *output, int width) const override;
+
+private:
+	float scale_x;
+	float scale_y;
+	float zenith_cos;
+	float zenith_sin;
+	float azimuth_cos;
+	float azimuth_sin;
+};
+
+//! Generic convolution with a square kernel of odd size.
+class RasterConvolutionKernel final : public RasterFocalKernel {
+public:
+	RasterConvolutionKernel(const vector<float> &weights, int size);
+
+	int GetHalo() const override {
+		return size / 2;
+	}
+	void ComputeRow(const float *const *rows, float *output, int width) const override;
+
+private:
+	vector<float> weights;
+	int size;
+};
+
+//! Applies focal (neighborhood) operations over Rasters.
+class RasterFocal {
+public:
+	//! Applies a kernel over the bands of a Raster and returns a new Float32 dataset. Tiles are processed in
+	//! parallel, each tile reads its own halo so tiles are independent, borders of the Raster are replicated.
+	//! Large outputs are written to a GeoTIFF in the temporary directory, whose path is set in 'temp_file_path'
+	//! (empty for in-memory outputs), the caller must delete it with the dataset.
+	static GDALDataset *Execute(ClientContext &context, GDALDataset *dataset, const vector<int> &band_numbers,
+	                            const RasterFocalKernel &kernel, string &temp_file_path);
+};
+
+} // namespace duckdb
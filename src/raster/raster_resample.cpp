@@ -0,0 +1,620 @@
+#include "raster_resample.hpp"
+#include "raster.hpp"
+#include "raster_tile_executor.hpp"
+
+// GDAL
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace duckdb {
+
+namespace {
+
+//======================================================================================================================
+// Pixel types
+//======================================================================================================================
+
+//! Traits of the pixel types:
+//! - sum_t: accumulator of the average, wide enough for the sum of a whole tile of source pixels.
+//! - work_t: working type of the convolutions, float is exact for 8 and 16 bit pixels, wider types need double.
+//! - HISTOGRAM: whether the mode is computed with a histogram of all the possible values (8 and 16 bit pixels).
+template <class T>
+struct PixelType {};
+
+template <>
+struct PixelType<uint8_t> {
+	static constexpr GDALDataType GDAL_TYPE = GDT_Byte;
+	static constexpr bool HISTOGRAM = true;
+	typedef uint64_t sum_t;
+	typedef float work_t;
+};
+template <>
+struct PixelType<uint16_t> {
+	static constexpr GDALDataType GDAL_TYPE = GDT_UInt16;
+	static constexpr bool HISTOGRAM = true;
+	typedef uint64_t sum_t;
+	typedef float work_t;
+};
+template <>
+struct PixelType<int16_t> {
+	static constexpr GDALDataType GDAL_TYPE = GDT_Int16;
+	static constexpr bool HISTOGRAM = true;
+	typedef int64_t sum_t;
+	typedef float work_t;
+};
+template <>
+struct PixelType<uint32_t> {
+	static constexpr GDALDataType GDAL_TYPE = GDT_UInt32;
+	static constexpr bool HISTOGRAM = false;
+	typedef uint64_t sum_t;
+	typedef double work_t;
+};
+template <>
+struct PixelType<int32_t> {
+	static constexpr GDALDataType GDAL_TYPE = GDT_Int32;
+	static constexpr bool HISTOGRAM = false;
+	typedef int64_t sum_t;
+	typedef double work_t;
+};
+template <>
+struct PixelType<float> {
+	static constexpr GDALDataType GDAL_TYPE = GDT_Float32;
+	static constexpr bool HISTOGRAM = false;
+	typedef double sum_t;
+	typedef float work_t;
+};
+template <>
+struct PixelType<double> {
+	static constexpr GDALDataType GDAL_TYPE = GDT_Float64;
+	static constexpr bool HISTOGRAM = false;
+	typedef double sum_t;
+	typedef double work_t;
+};
+
+//! Maximum size of the square output tiles computed by a task
+constexpr int RESAMPLE_TILE_SIZE = 256;
+//! Maximum width and height of the source window read by a task, output tiles are shrunk when downsampling by a large
+//! factor
+constexpr int RESAMPLE_MAX_SOURCE_SIZE = 1024;
+//! Minimum sum of the weights of the valid taps of a convolution, below it the output pixel is NODATA
+constexpr double RESAMPLE_MIN_WEIGHT = 1e-5;
+
+//! Converts a computed value to a pixel value, rounding and clamping integer types
+template <class T>
+inline T ToPixel(double value) {
+	if (std::is_integral<T>::value) {
+		value = std::floor(value + 0.5);
+		value = value < static_cast<double>(std::numeric_limits<T>::lowest())
+		            ? static_cast<double>(std::numeric_limits<T>::lowest())
+		            : value;
+		value = value > static_cast<double>(std::numeric_limits<T>::max())
+		            ? static_cast<double>(std::numeric_limits<T>::max())
+		            : value;
+	}
+	return static_cast<T>(value);
+}
+
+//======================================================================================================================
+// Sampling
+//======================================================================================================================
+
+//! The source pixels (taps) and weights used to compute the output pixels along one axis, indexes are relative to the
+//! first source pixel read for the tile.
+struct AxisSampling {
+	int taps;
+	vector<int> indexes;
+	vector<double> weights;
+	//! For average and mode, the range of source pixels [start, end) of each output pixel
+	vector<int> starts;
+	vector<int> ends;
+	//! Range of source pixels read for the tile
+	int source_off;
+	int source_size;
+};
+
+//! Cubic convolution kernel (Keys, a = -0.5)
+inline double CubicWeight(double x) {
+	x = std::fabs(x);
+	if (x < 1.0) {
+		return (1.5 * x - 2.5) * x * x + 1.0;
+	}
+	if (x < 2.0) {
+		return ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0;
+	}
+	return 0.0;
+}
+
+//! Computes the sampling of the output pixels [out_off, out_off + out_size) of an axis
+AxisSampling GetAxisSampling(RasterResampleMethod method, int source_count, int output_count, int out_off,
+                             int out_size) {
+	AxisSampling sampling;
+	const double factor = static_cast<double>(source_count) / output_count;
+
+	int min_index = source_count;
+	int max_index = 0;
+
+	switch (method) {
+	case RasterResampleMethod::NEAREST:
+	case RasterResampleMethod::BILINEAR:
+	case RasterResampleMethod::CUBIC: {
+		sampling.taps = method == RasterResampleMethod::NEAREST    ? 1
+		                : method == RasterResampleMethod::BILINEAR ? 2
+		                                                           : 4;
+		sampling.indexes.resize(static_cast<size_t>(sampling.taps) * out_size);
+		sampling.weights.resize(static_cast<size_t>(sampling.taps) * out_size);
+
+		for (int o = 0; o < out_size; o++) {
+			// Center of the output pixel in source pixel coordinates
+			double center = (out_off + o + 0.5) * factor - 0.5;
+			int first = method == RasterResampleMethod::NEAREST
+			                ? static_cast<int>(std::floor(center + 0.5))
+			                : static_cast<int>(std::floor(center)) - (method == RasterResampleMethod::CUBIC ? 1 : 0);
+
+			for (int k = 0; k < sampling.taps; k++) {
+				int index = MinValue(source_count - 1, MaxValue(0, first + k));
+				double distance = center - (first + k);
+				double weight = method == RasterResampleMethod::NEAREST    ? 1.0
+				                : method == RasterResampleMethod::BILINEAR ? 1.0 - std::fabs(distance)
+				                                                           : CubicWeight(distance);
+
+				// Taps are stored per tap, so the inner loops over output pixels are contiguous
+				sampling.indexes[k * out_size + o] = index;
+				sampling.weights[k * out_size + o] = weight;
+				min_index = MinValue(min_index, index);
+				max_index = MaxValue(max_index, index);
+			}
+		}
+		break;
+	}
+	case RasterResampleMethod::AVERAGE:
+	case RasterResampleMethod::MODE: {
+		sampling.taps = 0;
+		sampling.starts.resize(out_size);
+		sampling.ends.resize(out_size);
+
+		for (int o = 0; o < out_size; o++) {
+			int start = MinValue(source_count - 1, static_cast<int>(std::floor((out_off + o) * factor)));
+			int end = MinValue(source_count, static_cast<int>(std::ceil((out_off + o + 1) * factor - 1e-9)));
+			end = MaxValue(start + 1, end);
+
+			sampling.starts[o] = start;
+			sampling.ends[o] = end;
+			min_index = MinValue(min_index, start);
+			max_index = MaxValue(max_index, end - 1);
+		}
+		break;
+	}
+	}
+
+	// Make indexes relative to the window of source pixels
+	sampling.source_off = min_index;
+	sampling.source_size = max_index - min_index + 1;
+
+	for (auto &index : sampling.indexes) {
+		index -= min_index;
+	}
+	for (auto &index : sampling.starts) {
+		index -= min_index;
+	}
+	for (auto &index : sampling.ends) {
+		index -= min_index;
+	}
+	return sampling;
+}
+
+//======================================================================================================================
+// Kernels
+//======================================================================================================================
+
+//! The state of a band being resampled
+struct BandInfo {
+	bool has_nodata;
+	double nodata_value;
+};
+
+//! Nearest neighbour, a plain gather of the source pixels without any conversion
+template <class T>
+void ResampleNearest(const T *source, int source_x_size, const AxisSampling &sx, const AxisSampling &sy, T *output) {
+	const int out_x_size = static_cast<int>(sx.indexes.size());
+	const int out_y_size = static_cast<int>(sy.indexes.size());
+	const int *x_indexes = sx.indexes.data();
+
+	for (int y = 0; y < out_y_size; y++) {
+		const T *row = source + static_cast<size_t>(sy.indexes[y]) * source_x_size;
+		T *target = output + static_cast<size_t>(y) * out_x_size;
+
+		for (int x = 0; x < out_x_size; x++) {
+			target[x] = row[x_indexes[x]];
+		}
+	}
+}
+
+//! Bilinear and cubic convolution, separable: each tap row is interpolated horizontally and accumulated with its
+//! vertical weight. As in GDAL, NODATA taps are skipped and the result is normalized by the sum of the weights of the
+//! valid taps, so NODATA areas do not grow; output pixels without valid taps are NODATA.
+template <class T>
+void ResampleConvolution(const T *source, int source_x_size, const AxisSampling &sx, const AxisSampling &sy,
+                         const BandInfo &band, T *output) {
+	typedef typename PixelType<T>::work_t work_t;
+
+	const int out_x_size = static_cast<int>(sx.indexes.size() / sx.taps);
+	const int out_y_size = static_cast<int>(sy.indexes.size() / sy.taps);
+	const T nodata_value = static_cast<T>(band.nodata_value);
+	const T nodata_output = static_cast<T>(band.has_nodata ? band.nodata_value : 0);
+
+	const vector<work_t> weights(sx.weights.begin(), sx.weights.end());
+	// Values of a tap row with 0 for the invalid pixels (NODATA or NaN), and 1 or 0 whether they are valid
+	vector<work_t> row_values(source_x_size);
+	vector<work_t> row_valid(source_x_size);
+	vector<work_t> horizontal(out_x_size);
+	vector<work_t> horizontal_weight(out_x_size);
+	vector<work_t> accumulator(out_x_size);
+	vector<work_t> accumulator_weight(out_x_size);
+
+	for (int y = 0; y < out_y_size; y++) {
+		std::fill(accumulator.begin(), accumulator.end(), work_t(0));
+		std::fill(accumulator_weight.begin(), accumulator_weight.end(), work_t(0));
+
+		for (int ky = 0; ky < sy.taps; ky++) {
+			const T *row = source + static_cast<size_t>(sy.indexes[ky * out_y_size + y]) * source_x_size;
+			const work_t y_weight = static_cast<work_t>(sy.weights[ky * out_y_size + y]);
+
+			for (int x = 0; x < source_x_size; x++) {
+				const bool valid = !(band.has_nodata && row[x] == nodata_value) && row[x] == row[x];
+				row_values[x] = valid ? static_cast<work_t>(row[x]) : work_t(0);
+				row_valid[x] = valid ? work_t(1) : work_t(0);
+			}
+
+			std::fill(horizontal.begin(), horizontal.end(), work_t(0));
+			std::fill(horizontal_weight.begin(), horizontal_weight.end(), work_t(0));
+			for (int kx = 0; kx < sx.taps; kx++) {
+				const int *x_indexes = sx.indexes.data() + kx * out_x_size;
+				const work_t *x_weights = weights.data() + kx * out_x_size;
+
+				for (int x = 0; x < out_x_size; x++) {
+					horizontal[x] += x_weights[x] * row_values[x_indexes[x]];
+					horizontal_weight[x] += x_weights[x] * row_valid[x_indexes[x]];
+				}
+			}
+			for (int x = 0; x < out_x_size; x++) {
+				accumulator[x] += y_weight * horizontal[x];
+				accumulator_weight[x] += y_weight * horizontal_weight[x];
+			}
+		}
+
+		T *target = output + static_cast<size_t>(y) * out_x_size;
+		for (int x = 0; x < out_x_size; x++) {
+			target[x] = accumulator_weight[x] > RESAMPLE_MIN_WEIGHT
+			                ? ToPixel<T>(static_cast<double>(accumulator[x]) / accumulator_weight[x])
+			                : nodata_output;
+		}
+	}
+}
+
+//! Average of the valid source pixels covered by each output pixel. Source rows are first summed column-wise in
+//! integer accumulators for integer types, so the inner loop is a plain add over contiguous memory.
+template <class T>
+void ResampleAverage(const T *source, int source_x_size, const AxisSampling &sx, const AxisSampling &sy,
+                     const BandInfo &band, T *output) {
+	typedef typename PixelType<T>::sum_t sum_t;
+
+	const int out_x_size = static_cast<int>(sx.starts.size());
+	const int out_y_size = static_cast<int>(sy.starts.size());
+	const T nodata_value = static_cast<T>(band.nodata_value);
+	const T nodata_output = static_cast<T>(band.has_nodata ? band.nodata_value : 0);
+
+	vector<sum_t> column_sums(source_x_size);
+	vector<uint32_t> column_counts(source_x_size);
+
+	for (int y = 0; y < out_y_size; y++) {
+		std::fill(column_sums.begin(), column_sums.end(), sum_t(0));
+		std::fill(column_counts.begin(), column_counts.end(), 0);
+
+		for (int sy_idx = sy.starts[y]; sy_idx < sy.ends[y]; sy_idx++) {
+			const T *row = source + static_cast<size_t>(sy_idx) * source_x_size;
+
+			if (band.has_nodata) {
+				for (int x = 0; x < source_x_size; x++) {
+					const bool valid = row[x] != nodata_value && row[x] == row[x];
+					column_sums[x] += valid ? static_cast<sum_t>(row[x]) : sum_t(0);
+					column_counts[x] += valid ? 1 : 0;
+				}
+			} else {
+				for (int x = 0; x < source_x_size; x++) {
+					column_sums[x] += static_cast<sum_t>(row[x]);
+				}
+			}
+		}
+
+		T *target = output + static_cast<size_t>(y) * out_x_size;
+		const uint32_t row_count = static_cast<uint32_t>(sy.ends[y] - sy.starts[y]);
+
+		for (int x = 0; x < out_x_size; x++) {
+			sum_t sum = 0;
+			uint32_t count = 0;
+			for (int sx_idx = sx.starts[x]; sx_idx < sx.ends[x]; sx_idx++) {
+				sum += column_sums[sx_idx];
+				count += band.has_nodata ? column_counts[sx_idx] : row_count;
+			}
+			target[x] = count ? ToPixel<T>(static_cast<double>(sum) / count) : nodata_output;
+		}
+	}
+}
+
+//! Most frequent valid value of the source pixels covered by each output pixel, ties resolve to the lowest value.
+//! For 8 and 16 bit pixels, the values are counted in a histogram of all the possible values that is reused by all
+//! the output pixels, only the entries of the values found are reset.
+template <class T>
+void ResampleMode(const T *source, int source_x_size, const AxisSampling &sx, const AxisSampling &sy,
+                  const BandInfo &band, T *output, std::true_type) {
+	typedef typename std::make_unsigned<T>::type index_t;
+
+	const int out_x_size = static_cast<int>(sx.starts.size());
+	const int out_y_size = static_cast<int>(sy.starts.size());
+	const T nodata_value = static_cast<T>(band.nodata_value);
+	const T nodata_output = static_cast<T>(band.has_nodata ? band.nodata_value : 0);
+
+	vector<uint32_t> histogram(static_cast<size_t>(std::numeric_limits<index_t>::max()) + 1, 0);
+	vector<T> values;
+
+	for (int y = 0; y < out_y_size; y++) {
+		T *target = output + static_cast<size_t>(y) * out_x_size;
+
+		for (int x = 0; x < out_x_size; x++) {
+			values.clear();
+			for (int sy_idx = sy.starts[y]; sy_idx < sy.ends[y]; sy_idx++) {
+				const T *row = source + static_cast<size_t>(sy_idx) * source_x_size;
+				for (int sx_idx = sx.starts[x]; sx_idx < sx.ends[x]; sx_idx++) {
+					if (!band.has_nodata || row[sx_idx] != nodata_value) {
+						if (histogram[static_cast<index_t>(row[sx_idx])]++ == 0) {
+							values.push_back(row[sx_idx]);
+						}
+					}
+				}
+			}
+			if (values.empty()) {
+				target[x] = nodata_output;
+				continue;
+			}
+
+			T best_value = values[0];
+			uint32_t best_count = 0;
+			for (auto value : values) {
+				auto &count = histogram[static_cast<index_t>(value)];
+				if (count > best_count || (count == best_count && value < best_value)) {
+					best_value = value;
+					best_count = count;
+				}
+				count = 0;
+			}
+			target[x] = best_value;
+		}
+	}
+}
+
+//! Mode of wider pixel types, the valid values of each output pixel are sorted to find the longest run.
+template <class T>
+void ResampleMode(const T *source, int source_x_size, const AxisSampling &sx, const AxisSampling &sy,
+                  const BandInfo &band, T *output, std::false_type) {
+	const int out_x_size = static_cast<int>(sx.starts.size());
+	const int out_y_size = static_cast<int>(sy.starts.size());
+	const T nodata_value = static_cast<T>(band.nodata_value);
+	const T nodata_output = static_cast<T>(band.has_nodata ? band.nodata_value : 0);
+
+	vector<T> values;
+
+	for (int y = 0; y < out_y_size; y++) {
+		T *target = output + static_cast<size_t>(y) * out_x_size;
+
+		for (int x = 0; x < out_x_size; x++) {
+			values.clear();
+			for (int sy_idx = sy.starts[y]; sy_idx < sy.ends[y]; sy_idx++) {
+				const T *row = source + static_cast<size_t>(sy_idx) * source_x_size;
+				for (int sx_idx = sx.starts[x]; sx_idx < sx.ends[x]; sx_idx++) {
+					if ((!band.has_nodata || row[sx_idx] != nodata_value) && row[sx_idx] == row[sx_idx]) {
+						values.push_back(row[sx_idx]);
+					}
+				}
+			}
+			if (values.empty()) {
+				target[x] = nodata_output;
+				continue;
+			}
+
+			std::sort(values.begin(), values.end());
+			T best_value = values[0];
+			size_t best_count = 0;
+			for (size_t i = 0; i < values.size();) {
+				size_t j = i;
+				while (j < values.size() && values[j] == values[i]) {
+					j++;
+				}
+				if (j - i > best_count) {
+					best_value = values[i];
+					best_count = j - i;
+				}
+				i = j;
+			}
+			target[x] = best_value;
+		}
+	}
+}
+
+//! Returns the size of the output tiles along an axis, shrunk by the downsampling factor so the source window of a
+//! tile is at most RESAMPLE_MAX_SOURCE_SIZE pixels (unless a single output pixel covers more)
+inline int GetTileSize(int source_count, int output_count) {
+	const double factor = static_cast<double>(source_count) / output_count;
+	return MaxValue(1, MinValue(RESAMPLE_TILE_SIZE, static_cast<int>(RESAMPLE_MAX_SOURCE_SIZE / factor)));
+}
+
+//! Resamples all tiles of all bands of a Raster with the kernels of a pixel type
+template <class T>
+void ResampleTiles(ClientContext &context, GDALDataset *dataset, GDALDataset *output, RasterResampleMethod method) {
+	const int source_cols = dataset->GetRasterXSize();
+	const int source_rows = dataset->GetRasterYSize();
+	const int cols = output->GetRasterXSize();
+	const int rows = output->GetRasterYSize();
+	const int band_count = dataset->GetRasterCount();
+
+	vector<BandInfo> bands(band_count);
+	for (int b = 0; b < band_count; b++) {
+		int has_nodata = FALSE;
+		bands[b].nodata_value = dataset->GetRasterBand(b + 1)->GetNoDataValue(&has_nodata);
+		bands[b].has_nodata = has_nodata != FALSE;
+	}
+
+	// Square output tiles when the factors are the same, so the source window of a task is compact whatever the
+	// shape of the raster, and bounded whatever the downsampling factors
+	const int tile_x_size = GetTileSize(source_cols, cols);
+	const int tile_y_size = GetTileSize(source_rows, rows);
+
+	vector<RasterWindow> tiles;
+	for (int y = 0; y < rows; y += tile_y_size) {
+		for (int x = 0; x < cols; x += tile_x_size) {
+			tiles.emplace_back(x, y, MinValue(tile_x_size, cols - x), MinValue(tile_y_size, rows - y));
+		}
+	}
+	auto tile_count = tiles.size();
+	RasterTileExecutor executor(context, dataset);
+
+	executor.Execute(tile_count * band_count, [&](RasterTileReader &reader, idx_t task_idx) {
+		auto &tile = tiles[task_idx % tile_count];
+		auto band_idx = static_cast<int>(task_idx / tile_count);
+		auto &band = bands[band_idx];
+
+		auto sx = GetAxisSampling(method, source_cols, cols, tile.x_off, tile.x_size);
+		auto sy = GetAxisSampling(method, source_rows, rows, tile.y_off, tile.y_size);
+
+		vector<T> source(static_cast<size_t>(sx.source_size) * sy.source_size);
+		reader.Read(band_idx + 1, RasterWindow(sx.source_off, sy.source_off, sx.source_size, sy.source_size),
+		            PixelType<T>::GDAL_TYPE, source.data(), sx.source_size, sy.source_size);
+
+		vector<T> result(static_cast<size_t>(tile.x_size) * tile.y_size);
+
+		switch (method) {
+		case RasterResampleMethod::NEAREST:
+			ResampleNearest<T>(source.data(), sx.source_size, sx, sy, result.data());
+			break;
+		case RasterResampleMethod::BILINEAR:
+		case RasterResampleMethod::CUBIC:
+			ResampleConvolution<T>(source.data(), sx.source_size, sx, sy, band, result.data());
+			break;
+		case RasterResampleMethod::AVERAGE:
+			ResampleAverage<T>(source.data(), sx.source_size, sx, sy, band, result.data());
+			break;
+		case RasterResampleMethod::MODE:
+			ResampleMode<T>(source.data(), sx.source_size, sx, sy, band, result.data(),
+			                std::integral_constant<bool, PixelType<T>::HISTOGRAM>());
+			break;
+		}
+
+		lock_guard<mutex> guard(executor.GetWriteLock());
+		if (output->GetRasterBand(band_idx + 1)->RasterIO(GF_Write, tile.x_off, tile.y_off, tile.x_size, tile.y_size,
+		                                                  result.data(), tile.x_size, tile.y_size,
+		                                                  PixelType<T>::GDAL_TYPE, 0, 0) != CE_None) {
+			throw IOException("Could not write output tile: " + Raster::GetLastErrorMsg());
+		}
+	});
+}
+
+} // namespace
+
+//======================================================================================================================
+// RasterResample
+//======================================================================================================================
+
+RasterResampleMethod RasterResample::GetMethod(const string &name) {
+	auto lower_name = StringUtil::Lower(name);
+
+	if (lower_name == "nearest" || lower_name == "near") {
+		return RasterResampleMethod::NEAREST;
+	} else if (lower_name == "bilinear") {
+		return RasterResampleMethod::BILINEAR;
+	} else if (lower_name == "cubic") {
+		return RasterResampleMethod::CUBIC;
+	} else if (lower_name == "average") {
+		return RasterResampleMethod::AVERAGE;
+	} else if (lower_name == "mode") {
+		return RasterResampleMethod::MODE;
+	}
+	throw InvalidInputException("Unsupported resampling method '%s', expected one of nearest, bilinear, cubic, "
+	                            "average or mode",
+	                            name);
+}
+
+GDALDataset *RasterResample::Execute(ClientContext &context, GDALDataset *dataset, int cols, int rows,
+                                     RasterResampleMethod method) {
+	auto band_count = dataset->GetRasterCount();
+	if (band_count == 0) {
+		throw InvalidInputException("Input Raster has no RasterBands");
+	}
+	if (cols <= 0 || rows <= 0) {
+		throw InvalidInputException("The size of the resampled raster must be positive, got %dx%d", cols, rows);
+	}
+	auto data_type = dataset->GetRasterBand(1)->GetRasterDataType();
+
+	// Output dataset, same extent with the new pixel size
+	auto driver = GetGDALDriverManager()->GetDriverByName("MEM");
+	auto output = GDALDatasetUniquePtr(driver->Create("", cols, rows, band_count, data_type, nullptr));
+
+	if (!output) {
+		throw IOException("Could not create output raster: " + Raster::GetLastErrorMsg());
+	}
+
+	double gt[6];
+	Raster(dataset).GetGeoTransform(gt);
+	const double x_factor = static_cast<double>(dataset->GetRasterXSize()) / cols;
+	const double y_factor = static_cast<double>(dataset->GetRasterYSize()) / rows;
+	gt[1] *= x_factor;
+	gt[4] *= x_factor;
+	gt[2] *= y_factor;
+	gt[5] *= y_factor;
+	output->SetGeoTransform(gt);
+	output->SetSpatialRef(dataset->GetSpatialRef());
+
+	for (int b = 1; b <= band_count; b++) {
+		auto source_band = dataset->GetRasterBand(b);
+		auto target_band = output->GetRasterBand(b);
+		int has_nodata = FALSE;
+		auto nodata_value = source_band->GetNoDataValue(&has_nodata);
+
+		if (has_nodata) {
+			target_band->SetNoDataValue(nodata_value);
+		}
+		target_band->SetColorInterpretation(source_band->GetColorInterpretation());
+	}
+
+	switch (data_type) {
+	case GDT_Byte:
+		ResampleTiles<uint8_t>(context, dataset, output.get(), method);
+		break;
+	case GDT_UInt16:
+		ResampleTiles<uint16_t>(context, dataset, output.get(), method);
+		break;
+	case GDT_Int16:
+		ResampleTiles<int16_t>(context, dataset, output.get(), method);
+		break;
+	case GDT_UInt32:
+		ResampleTiles<uint32_t>(context, dataset, output.get(), method);
+		break;
+	case GDT_Int32:
+		ResampleTiles<int32_t>(context, dataset, output.get(), method);
+		break;
+	case GDT_Float32:
+		ResampleTiles<float>(context, dataset, output.get(), method);
+		break;
+	case GDT_Float64:
+		ResampleTiles<double>(context, dataset, output.get(), method);
+		break;
+	default:
+		throw NotImplementedException("Resampling rasters of type %s is not supported", GDALGetDataTypeName(data_type));
+	}
+
+	return output.release();
+}
+
+} // namespace duckdb
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+class GDALDataset;
+
+namespace duckdb {
+
+class ClientContext;
+
+//! The methods to compute the pixels of a resampled Raster.
+enum class RasterResampleMethod : uint8_t { NEAREST, BILINEAR, CUBIC, AVERAGE, MODE };
+
+//! Resamples Rasters to another size.
+class RasterResample {
+public:
+	//! Returns the method of the given name, throws if it is unknown
+	static RasterResampleMethod GetMethod(const string &name);
+
+	//! Resamples all bands of a Raster to a new size and returns a new MEM dataset with the same data type, NODATA
+	//! values and extent. Output tiles are computed in parallel, with kernels specialized per pixel type.
+	static GDALDataset *Execute(ClientContext &context, GDALDataset *dataset, int cols, int rows,
+	                            RasterResampleMethod method);
+};
+
+} // namespace duckdb
@@ -0,0 +1,703 @@
+#include "raster_types.hpp"
+#include "raster.hpp"
+#include "raster_focal.hpp"
+#include "raster_resample.hpp"
+#include "raster_scalar_functions.hpp"
+
+// DuckDB
+#include "duckdb/common/vector_operations/binary_executor.hpp"
+#include "duckdb/common/vector_operations/ternary_executor.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/extension_util.hpp"
+// Spatial
+#include "spatial/util/function_builder.hpp"
+// GDAL
+#include "gdal_priv.h"
+#include "ogr_geometry.h"
+#include "ogr_spatialref.h"
+#include "gdal_context_state.hpp"
+
+namespace duckdb {
+
+namespace {
+
+//======================================================================================================================
+// RT_Clip
+//======================================================================================================================
+
+struct RT_Clip {
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Execute
+	//------------------------------------------------------------------------------------------------------------------
+
+	static uintptr_t ClipByGeometry(ClientContext &context, uintptr_t input, const string_t &wkb,
+	                                const OGRSpatialReference *srs, ValidityMask &mask, idx_t idx) {
+		OGRGeometry *geometry = nullptr;
+		if (OGRGeometryFactory::createFromWkb(wkb.GetData(), nullptr, &geometry, wkb.GetSize()) != OGRERR_NONE) {
+			throw InvalidInputException("RT_Clip: invalid WKB geometry");
+		}
+		unique_ptr<OGRGeometry> geometry_ptr(geometry);
+
+		Raster raster(reinterpret_cast<GDALDataset *>(input));
+		if (!raster.HasSameSpatialRef(srs)) {
+			throw InvalidInputException("RT_Clip: the geometry is not in the coordinate system of the raster");
+		}
+		auto clipped = raster.ClipByGeometry(*geometry);
+
+		if (clipped == nullptr) {
+			mask.SetInvalid(idx);
+			return uintptr_t(0);
+		}
+		GDALClientContextState::GetOrCreate(context).GetDatasetRegistry(context).RegisterDataset(clipped);
+		return CastPointerToValue(clipped);
+	}
+
+	static void ExecuteGeometry(DataChunk &args, ExpressionState &state, Vector &result) {
+		auto &context = state.GetContext();
+
+		if (args.ColumnCount() == 2) {
+			BinaryExecutor::ExecuteWithNulls<uintptr_t, string_t, uintptr_t>(
+			    args.data[0], args.data[1], result, args.size(),
+			    [&](uintptr_t input, string_t wkb, ValidityMask &mask, idx_t idx) {
+				    return ClipByGeometry(context, input, wkb, nullptr, mask, idx);
+			    });
+			return;
+		}
+
+		// The coordinate system of the geometry is given, it must be the one of the raster
+		TernaryExecutor::ExecuteWithNulls<uintptr_t, string_t, string_t, uintptr_t>(
+		    args.data[0], args.data[1], args.data[2], result, args.size(),
+		    [&](uintptr_t input, string_t wkb, string_t srs_text, ValidityMask &mask, idx_t idx) {
+			    OGRSpatialReference srs;
+			    if (srs.SetFromUserInput(srs_text.GetString().c_str()) != OGRERR_NONE) {
+				    throw InvalidInputException("RT_Clip: invalid srs '%s'", srs_text.GetString());
+			    }
+			    return ClipByGeometry(context, input, wkb, &srs, mask, idx);
+		    });
+	}
+
+	static void ExecuteExtent(DataChunk &args, ExpressionState &state, Vector &result) {
+		auto &context = state.GetContext();
+		auto &ctx_state = GDALClientContextState::GetOrCreate(context);
+
+		auto &extent_vector = args.data[1];
+		auto &extent_child = ListVector::GetEntry(extent_vector);
+		UnifiedVectorFormat extent_format;
+		extent_child.ToUnifiedFormat(ListVector::GetListSize(extent_vector), extent_format);
+		auto extent_data = UnifiedVectorFormat::GetData<double>(extent_format);
+
+		BinaryExecutor::ExecuteWithNulls<uintptr_t, list_entry_t, uintptr_t>(
+		    args.data[0], extent_vector, result, args.size(),
+		    [&](uintptr_t input, list_entry_t extent, ValidityMask &mask, idx_t idx) {
+			    if (extent.length != 4) {
+				    throw InvalidInputException("RT_Clip: the extent must be a list of [min_x, min_y, max_x, max_y]");
+			    }
+			    double bounds[4];
+			    for (idx_t i = 0; i < 4; i++) {
+				    auto bound_idx = extent_format.sel->get_index(extent.offset + i);
+				    if (!extent_format.validity.RowIsValid(bound_idx)) {
+					    throw InvalidInputException("RT_Clip: the extent can not contain NULL values");
+				    }
+				    bounds[i] = extent_data[bound_idx];
+			    }
+
+			    Raster raster(reinterpret_cast<GDALDataset *>(input));
+			    auto clipped = raster.ClipByExtent(bounds[0], bounds[1], bounds[2], bounds[3]);
+
+			    if (clipped == nullptr) {
+				    mask.SetInvalid(idx);
+				    return uintptr_t(0);
+			    }
+			    ctx_state.GetDatasetRegistry(context).RegisterDataset(clipped);
+			    return CastPointerToValue(clipped);
+		    });
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Documentation
+	//------------------------------------------------------------------------------------------------------------------
+
+	static constexpr auto DESCRIPTION = R"(
+		Returns a raster cropped to an extent or to a geometry.
+
+		The result is a lazy view of the source raster with an adjusted geotransform, so only the blocks intersecting the area of interest are read from the source, and nothing is copied into memory.
+
+		The extent is a list of `[min_x, min_y, max_x, max_y]` values. When clipping by a geometry (as a WKB blob, e.g. `ST_AsWKB(geom)`), the raster is cropped to the envelope of the geometry, and pixels outside the geometry are set to NODATA. A floating point band without NODATA value gets NaN. When an integer band has no NODATA value, no value of its type can be assumed unused, so the pixels outside the geometry are masked by an alpha band added after the bands of the raster instead (0 outside the geometry, 255 inside). The raster is never read to choose a NODATA value.
+
+		The extent and the geometry must be in the coordinate system of the raster. The coordinate system of the geometry can be given as a third parameter (e.g. 'EPSG:4326'), an error is raised when it is not the one of the raster.
+
+		Returns NULL if the raster does not intersect the area of interest.
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		SELECT RT_Clip(raster, [541420.0, 4790000.0, 545000.0, 4796000.0]) FROM RT_Read('some/file/path/filename.tif');
+	)";
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Register
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void Register(DatabaseInstance &db) {
+		FunctionBuilder::RegisterScalar(db, "RT_Clip", [](ScalarFunctionBuilder &func) {
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("geom", LogicalType::BLOB);
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(ExecuteGeometry);
+			});
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("geom", LogicalType::BLOB);
+				variant.AddParameter("srs", LogicalType::VARCHAR);
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(ExecuteGeometry);
+			});
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("extent", LogicalType::LIST(LogicalType::DOUBLE));
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(ExecuteExtent);
+			});
+
+			func.SetDescription(DESCRIPTION);
+			func.SetExample(EXAMPLE);
+			func.SetTag("ext", "spatial_raster");
+			func.SetTag("category", "construction");
+		});
+	}
+};
+
+//======================================================================================================================
+// RT_Align
+//======================================================================================================================
+
+struct RT_Align {
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Execute
+	//------------------------------------------------------------------------------------------------------------------
+
+	static uintptr_t Align(ClientContext &context, uintptr_t input, uintptr_t reference, const string &resampling) {
+		auto &ctx_state = GDALClientContextState::GetOrCreate(context);
+
+		Raster raster(reinterpret_cast<GDALDataset *>(input));
+		auto aligned = raster.AlignTo(reinterpret_cast<GDALDataset *>(reference), resampling);
+
+		if (aligned == nullptr) {
+			throw InvalidInputException("RT_Align: could not align the raster (%s)", Raster::GetLastErrorMsg());
+		}
+		ctx_state.GetDatasetRegistry(context).RegisterDataset(aligned);
+		return CastPointerToValue(aligned);
+	}
+
+	static void Execute(DataChunk &args, ExpressionState &state, Vector &result) {
+		auto &context = state.GetContext();
+
+		BinaryExecutor::Execute<uintptr_t, uintptr_t, uintptr_t>(
+		    args.data[0], args.data[1], result, args.size(),
+		    [&](uintptr_t input, uintptr_t reference) { return Align(context, input, reference, "near"); });
+	}
+
+	static void ExecuteWithResampling(DataChunk &args, ExpressionState &state, Vector &result) {
+		auto &context = state.GetContext();
+
+		TernaryExecutor::Execute<uintptr_t, uintptr_t, string_t, uintptr_t>(
+		    args.data[0], args.data[1], args.data[2], result, args.size(),
+		    [&](uintptr_t input, uintptr_t reference, string_t resampling) {
+			    return Align(context, input, reference, StringUtil::Lower(resampling.GetString()));
+		    });
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Documentation
+	//------------------------------------------------------------------------------------------------------------------
+
+	static constexpr auto DESCRIPTION = R"(
+		Returns a raster resampled onto the grid of a reference raster, so both can be combined pixel by pixel.
+
+		The result has the coordinate system, extent and size of the reference raster. It is a lazy view of the source raster, blocks are warped on demand when they are read, so nothing is copied into memory. Pixels outside the source raster are NODATA (or 0 when the band has no NODATA value).
+
+		The optional `resampling` method is one of near (default), bilinear, cubic, cubicspline, lanczos, average, mode, min, max, med, q1 or q3.
+
+		See [RT_Zip](#rt_zip) to stream the matching pixels of two aligned rasters.
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		SELECT RT_Align(dem.raster, landcover.raster, 'bilinear')
+		FROM RT_Read('some/file/path/dem.tif') dem, RT_Read('some/file/path/landcover.tif') landcover;
+	)";
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Register
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void Register(DatabaseInstance &db) {
+		FunctionBuilder::RegisterScalar(db, "RT_Align", [](ScalarFunctionBuilder &func) {
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("reference", RasterTypes::RASTER());
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("reference", RasterTypes::RASTER());
+				variant.AddParameter("resampling", LogicalType::VARCHAR);
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(ExecuteWithResampling);
+			});
+
+			func.SetDescription(DESCRIPTION);
+			func.SetExample(EXAMPLE);
+			func.SetTag("ext", "spatial_raster");
+			func.SetTag("category", "construction");
+		});
+	}
+};
+
+//======================================================================================================================
+// RT_Resample
+//======================================================================================================================
+
+struct RT_Resample {
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Execute
+	//------------------------------------------------------------------------------------------------------------------
+
+	//! Returns the size of the resampled raster, from a scale factor (DOUBLE) or a [width, height] list
+	static void GetOutputSize(GDALDataset *dataset, const Value &value, int &cols, int &rows) {
+		if (value.type().id() == LogicalTypeId::LIST) {
+			auto &sizes = ListValue::GetChildren(value);
+			if (sizes.size() != 2 || sizes[0].IsNull() || sizes[1].IsNull()) {
+				throw InvalidInputException("RT_Resample: size must be a list of two values [width, height]");
+			}
+			cols = sizes[0].GetValue<int32_t>();
+			rows = sizes[1].GetValue<int32_t>();
+
+			if (cols <= 0 || rows <= 0) {
+				throw InvalidInputException("RT_Resample: size must be positive, got [%d, %d]", cols, rows);
+			}
+			return;
+		}
+		auto scale = value.GetValue<double>();
+		if (!(scale > 0)) {
+			throw InvalidInputException("RT_Resample: scale must be positive, got %f", scale);
+		}
+		cols = MaxValue<int>(1, static_cast<int>(std::round(dataset->GetRasterXSize() * scale)));
+		rows = MaxValue<int>(1, static_cast<int>(std::round(dataset->GetRasterYSize() * scale)));
+	}
+
+	static void Execute(DataChunk &args, ExpressionState &state, Vector &result) {
+		auto &context = state.GetContext();
+		auto &ctx_state = GDALClientContextState::GetOrCreate(context);
+		auto count = args.size();
+
+		UnifiedVectorFormat raster_format;
+		args.data[0].ToUnifiedFormat(count, raster_format);
+		auto raster_data = UnifiedVectorFormat::GetData<uintptr_t>(raster_format);
+
+		result.SetVectorType(VectorType::FLAT_VECTOR);
+		auto result_data = FlatVector::GetData<uintptr_t>(result);
+
+		for (idx_t i = 0; i < count; i++) {
+			auto raster_idx = raster_format.sel->get_index(i);
+			auto size_value = args.data[1].GetValue(i);
+			auto method_value = args.ColumnCount() > 2 ? args.data[2].GetValue(i) : Value("nearest");
+
+			if (!raster_format.validity.RowIsValid(raster_idx) || size_value.IsNull() || method_value.IsNull()) {
+				FlatVector::SetNull(result, i, true);
+				continue;
+			}
+			auto dataset = reinterpret_cast<GDALDataset *>(raster_data[raster_idx]);
+			auto method = RasterResample::GetMethod(StringValue::Get(method_value));
+
+			int cols, rows;
+			GetOutputSize(dataset, size_value, cols, rows);
+
+			auto output = RasterResample::Execute(context, dataset, cols, rows, method);
+			ctx_state.GetDatasetRegistry(context).RegisterDataset(output);
+			result_data[i] = CastPointerToValue(output);
+		}
+
+		if (args.AllConstant()) {
+			result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Documentation
+	//------------------------------------------------------------------------------------------------------------------
+
+	static constexpr auto DESCRIPTION = R"(
+		Returns a raster resampled to another size (downsampled or upsampled), keeping its extent, data type and NODATA values.
+
+		The new size is either a `scale` factor applied to the width and height of the raster (e.g. 0.5 halves both) or an explicit `size` as a `[width, height]` list.
+
+		The optional `method` is one of nearest (default), bilinear, cubic, average or mode. Average and mode aggregate all the source pixels covered by each output pixel, ignoring NODATA, so they are the usual choice to downsample; bilinear and cubic interpolate the source pixels around the center of each output pixel.
+
+		The raster is computed in memory by output tiles in parallel, with kernels specialized for each pixel type.
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		SELECT RT_Resample(raster, 0.25, 'average') FROM RT_Read('some/file/path/dem.tif');
+		SELECT RT_Resample(raster, [256, 256], 'bilinear') FROM RT_Read('some/file/path/dem.tif');
+	)";
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Register
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void Register(DatabaseInstance &db) {
+		FunctionBuilder::RegisterScalar(db, "RT_Resample", [](ScalarFunctionBuilder &func) {
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("scale", LogicalType::DOUBLE);
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("scale", LogicalType::DOUBLE);
+				variant.AddParameter("method", LogicalType::VARCHAR);
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("size", LogicalType::LIST(LogicalType::INTEGER));
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("size", LogicalType::LIST(LogicalType::INTEGER));
+				variant.AddParameter("method", LogicalType::VARCHAR);
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+
+			func.SetDescription(DESCRIPTION);
+			func.SetExample(EXAMPLE);
+			func.SetTag("ext", "spatial_raster");
+			func.SetTag("category", "construction");
+		});
+	}
+};
+
+//======================================================================================================================
+// Focal (neighborhood) functions
+//======================================================================================================================
+
+struct RasterFocalFunction {
+
+	//! Applies a focal operation to the raster of each row, the kernel is created by the factory for each row and
+	//! it can return nullptr to set the result to NULL.
+	template <class KERNEL_FACTORY>
+	static void Execute(DataChunk &args, ExpressionState &state, Vector &result, bool all_bands,
+	                    KERNEL_FACTORY &&kernel_factory) {
+		auto &context = state.GetContext();
+		auto &ctx_state = GDALClientContextState::GetOrCreate(context);
+		auto count = args.size();
+
+		UnifiedVectorFormat raster_format;
+		args.data[0].ToUnifiedFormat(count, raster_format);
+		auto raster_data = UnifiedVectorFormat::GetData<uintptr_t>(raster_format);
+
+		result.SetVectorType(VectorType::FLAT_VECTOR);
+		auto result_data = FlatVector::GetData<uintptr_t>(result);
+
+		for (idx_t i = 0; i < count; i++) {
+			auto raster_idx = raster_format.sel->get_index(i);
+
+			if (!raster_format.validity.RowIsValid(raster_idx)) {
+				FlatVector::SetNull(result, i, true);
+				continue;
+			}
+			auto dataset = reinterpret_cast<GDALDataset *>(raster_data[raster_idx]);
+			auto kernel = kernel_factory(dataset, i);
+
+			if (!kernel) {
+				FlatVector::SetNull(result, i, true);
+				continue;
+			}
+
+			vector<int> band_numbers;
+			for (int band = 1; band <= (all_bands ? dataset->GetRasterCount() : 1); band++) {
+				band_numbers.push_back(band);
+			}
+			if (band_numbers.empty()) {
+				throw InvalidInputException("Input Raster has no RasterBands");
+			}
+
+			string temp_file_path;
+			auto output = RasterFocal::Execute(context, dataset, band_numbers, *kernel, temp_file_path);
+
+			if (temp_file_path.empty()) {
+				ctx_state.GetDatasetRegistry(context).RegisterDataset(output);
+			} else {
+				ctx_state.GetDatasetRegistry(context).RegisterTemporaryDataset(output, temp_file_path);
+			}
+			result_data[i] = CastPointerToValue(output);
+		}
+
+		if (args.AllConstant()) {
+			result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		}
+	}
+
+	//! Returns the size of the pixels of a raster
+	static void GetResolution(GDALDataset *dataset, double &res_x, double &res_y) {
+		double gt[6];
+		Raster(dataset).GetGeoTransform(gt);
+		res_x = std::sqrt(gt[1] * gt[1] + gt[4] * gt[4]);
+		res_y = std::sqrt(gt[2] * gt[2] + gt[5] * gt[5]);
+	}
+
+	//! Returns a DOUBLE argument of a row, or the default value when the function has not that argument
+	static bool GetDoubleArgument(DataChunk &args, idx_t arg_idx, idx_t row_idx, double default_value,
+	                              double &result) {
+		if (arg_idx >= args.ColumnCount()) {
+			result = default_value;
+			return true;
+		}
+		auto value = args.data[arg_idx].GetValue(row_idx);
+		if (value.IsNull()) {
+			return false;
+		}
+		result = value.GetValue<double>();
+		return true;
+	}
+};
+
+//======================================================================================================================
+// RT_Slope
+//======================================================================================================================
+
+struct RT_Slope {
+
+	static void Execute(DataChunk &args, ExpressionState &state, Vector &result) {
+		RasterFocalFunction::Execute(args, state, result, false, [&](GDALDataset *dataset, idx_t row_idx) {
+			double res_x, res_y, z_factor;
+			if (!RasterFocalFunction::GetDoubleArgument(args, 1, row_idx, 1.0, z_factor)) {
+				return unique_ptr<RasterFocalKernel>();
+			}
+			RasterFocalFunction::GetResolution(dataset, res_x, res_y);
+			return unique_ptr<RasterFocalKernel>(new RasterSlopeKernel(res_x, res_y, z_factor));
+		});
+	}
+
+	static constexpr auto DESCRIPTION = R"(
+		Returns the slope (in degrees) of the first band of an elevation raster.
+
+		The slope is computed with the Horn's method over a 3x3 window. The raster is processed by tiles in parallel, each tile is read with a halo of one pixel so tiles are independent. Pixels with NODATA neighbours are NODATA in the output.
+
+		The optional `z_factor` scales the elevation values, e.g. to convert them to the units of the coordinate system of the raster.
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		SELECT RT_Slope(raster) FROM RT_Read('some/file/path/dem.tif');
+	)";
+
+	static void Register(DatabaseInstance &db) {
+		FunctionBuilder::RegisterScalar(db, "RT_Slope", [](ScalarFunctionBuilder &func) {
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("z_factor", LogicalType::DOUBLE);
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+
+			func.SetDescription(DESCRIPTION);
+			func.SetExample(EXAMPLE);
+			func.SetTag("ext", "spatial_raster");
+			func.SetTag("category", "focal");
+		});
+	}
+};
+
+//======================================================================================================================
+// RT_Aspect
+//======================================================================================================================
+
+struct RT_Aspect {
+
+	static void Execute(DataChunk &args, ExpressionState &state, Vector &result) {
+		RasterFocalFunction::Execute(args, state, result, false, [&](GDALDataset *dataset, idx_t row_idx) {
+			return unique_ptr<RasterFocalKernel>(new RasterAspectKernel());
+		});
+	}
+
+	static constexpr auto DESCRIPTION = R"(
+		Returns the aspect (in degrees clockwise from north) of the first band of an elevation raster.
+
+		The aspect is computed with the Horn's method over a 3x3 window, flat areas are NODATA. The raster is processed by tiles in parallel, each tile is read with a halo of one pixel so tiles are independent.
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		SELECT RT_Aspect(raster) FROM RT_Read('some/file/path/dem.tif');
+	)";
+
+	static void Register(DatabaseInstance &db) {
+		FunctionBuilder::RegisterScalar(db, "RT_Aspect", [](ScalarFunctionBuilder &func) {
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+
+			func.SetDescription(DESCRIPTION);
+			func.SetExample(EXAMPLE);
+			func.SetTag("ext", "spatial_raster");
+			func.SetTag("category", "focal");
+		});
+	}
+};
+
+//======================================================================================================================
+// RT_Hillshade
+//======================================================================================================================
+
+struct RT_Hillshade {
+
+	static void Execute(DataChunk &args, ExpressionState &state, Vector &result) {
+		RasterFocalFunction::Execute(args, state, result, false, [&](GDALDataset *dataset, idx_t row_idx) {
+			double res_x, res_y, azimuth, altitude, z_factor;
+			if (!RasterFocalFunction::GetDoubleArgument(args, 1, row_idx, 315.0, azimuth) ||
+			    !RasterFocalFunction::GetDoubleArgument(args, 2, row_idx, 45.0, altitude) ||
+			    !RasterFocalFunction::GetDoubleArgument(args, 3, row_idx, 1.0, z_factor)) {
+				return unique_ptr<RasterFocalKernel>();
+			}
+			RasterFocalFunction::GetResolution(dataset, res_x, res_y);
+			return unique_ptr<RasterFocalKernel>(new RasterHillshadeKernel(res_x, res_y, z_factor, azimuth, altitude));
+		});
+	}
+
+	static constexpr auto DESCRIPTION = R"(
+		Returns the shaded relief in the [0, 255] range of the first band of an elevation raster.
+
+		The light source is placed at the given `azimuth` (315 by default) and `altitude` (45 by default), in degrees. The optional `z_factor` scales the elevation values. The raster is processed by tiles in parallel, each tile is read with a halo of one pixel so tiles are independent.
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		SELECT RT_Hillshade(raster, 315, 45) FROM RT_Read('some/file/path/dem.tif');
+	)";
+
+	static void Register(DatabaseInstance &db) {
+		FunctionBuilder::RegisterScalar(db, "RT_Hillshade", [](ScalarFunctionBuilder &func) {
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("azimuth", LogicalType::DOUBLE);
+				variant.AddParameter("altitude", LogicalType::DOUBLE);
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("azimuth", LogicalType::DOUBLE);
+				variant.AddParameter("altitude", LogicalType::DOUBLE);
+				variant.AddParameter("z_factor", LogicalType::DOUBLE);
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+
+			func.SetDescription(DESCRIPTION);
+			func.SetExample(EXAMPLE);
+			func.SetTag("ext", "spatial_raster");
+			func.SetTag("category", "focal");
+		});
+	}
+};
+
+//======================================================================================================================
+// RT_Convolve
+//======================================================================================================================
+
+struct RT_Convolve {
+
+	static void Execute(DataChunk &args, ExpressionState &state, Vector &result) {
+		RasterFocalFunction::Execute(args, state, result, true, [&](GDALDataset *dataset, idx_t row_idx) {
+			auto kernel_value = args.data[1].GetValue(row_idx);
+			if (kernel_value.IsNull()) {
+				return unique_ptr<RasterFocalKernel>();
+			}
+
+			auto &kernel_rows = ListValue::GetChildren(kernel_value);
+			auto size = static_cast<int>(kernel_rows.size());
+
+			if (size % 2 == 0) {
+				throw InvalidInputException("RT_Convolve: the kernel must be a square matrix of odd size");
+			}
+			vector<float> weights;
+			weights.reserve(size * size);
+
+			for (auto &kernel_row : kernel_rows) {
+				if (kernel_row.IsNull() || ListValue::GetChildren(kernel_row).size() != kernel_rows.size()) {
+					throw InvalidInputException("RT_Convolve: the kernel must be a square matrix of odd size");
+				}
+				for (auto &weight : ListValue::GetChildren(kernel_row)) {
+					weights.push_back(weight.IsNull() ? 0.0f : weight.GetValue<float>());
+				}
+			}
+			return unique_ptr<RasterFocalKernel>(new RasterConvolutionKernel(weights, size));
+		});
+	}
+
+	static constexpr auto DESCRIPTION = R"(
+		Returns the convolution of all bands of a raster with a kernel.
+
+		The kernel is a square matrix of odd size (e.g. 3x3 or 5x5) given as a list of rows. The raster is processed by tiles in parallel, each tile is read with a halo of half the kernel size so tiles are independent, borders of the raster are replicated. Pixels with NODATA neighbours are NODATA in the output. Outputs larger than a quarter of the DuckDB memory limit are written to a GeoTIFF in the temporary directory instead of being kept in memory.
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		-- 3x3 mean filter
+		SELECT RT_Convolve(raster, [[1/9, 1/9, 1/9], [1/9, 1/9, 1/9], [1/9, 1/9, 1/9]]) FROM RT_Read('some/file/path/filename.tif');
+	)";
+
+	static void Register(DatabaseInstance &db) {
+		FunctionBuilder::RegisterScalar(db, "RT_Convolve", [](ScalarFunctionBuilder &func) {
+			func.AddVariant([](ScalarFunctionVariantBuilder &variant) {
+				variant.AddParameter("raster", RasterTypes::RASTER());
+				variant.AddParameter("kernel", LogicalType::LIST(LogicalType::LIST(LogicalType::DOUBLE)));
+				variant.SetReturnType(RasterTypes::RASTER());
+				variant.SetFunction(Execute);
+			});
+
+			func.SetDescription(DESCRIPTION);
+			func.SetExample(EXAMPLE);
+			func.SetTag("ext", "spatial_raster");
+			func.SetTag("category", "focal");
+		});
+	}
+};
+
+} // namespace
+
+// ######################################################################################################################
+//  Register Raster Scalar Functions
+// ######################################################################################################################
+
+void GdalRasterScalarFunctions::Register(DatabaseInstance &db) {
+
+	// Register functions
+	RT_Clip::Register(db);
+	RT_Align::Register(db);
+	RT_Resample::Register(db);
+	RT_Slope::Register(db);
+	RT_Aspect::Register(db);
+	RT_Hillshade::Register(db);
+	RT_Convolve::Register(db);
+}
+
+} // namespace duckdb
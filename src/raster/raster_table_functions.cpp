@@ -1,19 +1,38 @@
 #include "raster_types.hpp"
 #include "raster_value.hpp"
 #include "raster.hpp"
+#include "raster_tile_executor.hpp"
 #include "raster_table_functions.hpp"
 
 // DuckDB
+#include "duckdb/common/insertion_order_preserving_map.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/extension_util.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/parser/expression/function_expression.hpp"
 #include "duckdb/parser/tableref/table_function_ref.hpp"
+#include "duckdb/planner/expression/bound_between_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
 // Spatial
 #include "spatial/util/function_builder.hpp"
 // GDAL
 #include "gdal_priv.h"
+#include "gdal_alg.h"
+#include "gdal_utils.h"
+#include "ogr_spatialref.h"
+#include "ogrsf_frmts.h"
 #include "gdal_dataset_factory.hpp"
 #include "gdal_context_state.hpp"
+#include "gdal_module.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace duckdb {
 
@@ -38,6 +57,9 @@ struct RT_Drivers {
 	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
 	                                     vector<LogicalType> &return_types, vector<string> &names) {
 
+		// Drivers are registered lazily, make sure the full list is available
+		GdalModule::RegisterAllDrivers();
+
 		return_types.emplace_back(LogicalType::VARCHAR);
 		return_types.emplace_back(LogicalType::VARCHAR);
 		return_types.emplace_back(LogicalType::BOOLEAN);
@@ -144,6 +166,18 @@ struct RT_Drivers {
 	}
 };
 
+//======================================================================================================================
+// Overviews
+//======================================================================================================================
+
+//! Adds the overview read for a target resolution to the parameters shown by EXPLAIN and the profiler
+void AddOverviewInfo(InsertionOrderPreservingMap<string> &result, double target_resolution, int overview_level) {
+	if (target_resolution > 0) {
+		result["Target Resolution"] = StringUtil::Format("%g", target_resolution);
+		result["Overview Level"] = overview_level >= 0 ? std::to_string(overview_level) : "none (full resolution)";
+	}
+}
+
 //======================================================================================================================
 // RT_Read
 //======================================================================================================================
@@ -158,8 +192,38 @@ struct RT_Read {
 		string file_name;
 		named_parameter_map_t parameters;
 		bool loaded;
+		//! The requested pixel size (0 when not set) and the overview level read for it, -1 is the full resolution
+		double target_resolution;
+		int overview_level;
 	};
 
+	//! Opens the file with the options of the function plus some extra open options
+	static GDALDataset *OpenFile(ClientContext &context, const BindData &bind_data,
+	                             const vector<string> &extra_options) {
+		auto gdal_open_options = GDALDatasetFactory::FromNamedParameters(bind_data.parameters, "open_options");
+		auto gdal_allowed_drivers = GDALDatasetFactory::FromNamedParameters(bind_data.parameters, "allowed_drivers");
+		auto gdal_sibling_files = GDALDatasetFactory::FromNamedParameters(bind_data.parameters, "sibling_files");
+
+		// Extra options are appended to the null-terminated list of open options
+		for (auto &option : extra_options) {
+			if (gdal_open_options.empty()) {
+				gdal_open_options.push_back(nullptr);
+			}
+			gdal_open_options.insert(gdal_open_options.end() - 1, option.c_str());
+		}
+
+		auto dataset = GDALDatasetFactory::Open(context, bind_data.file_name,
+		                                        gdal_allowed_drivers.empty() ? nullptr : gdal_allowed_drivers.data(),
+		                                        gdal_open_options.empty() ? nullptr : gdal_open_options.data(),
+		                                        gdal_sibling_files.empty() ? nullptr : gdal_sibling_files.data());
+
+		if (dataset == nullptr) {
+			auto error = Raster::GetLastErrorMsg();
+			throw IOException("Could not open file: " + bind_data.file_name + " (" + error + ")");
+		}
+		return dataset;
+	}
+
 	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
 	                                     vector<LogicalType> &return_types, vector<string> &names) {
 		return_types.emplace_back(LogicalType::VARCHAR);
@@ -174,6 +238,25 @@ struct RT_Read {
 		result->file_name = raw_file_name;
 		result->parameters = parameters;
 		result->loaded = false;
+		result->target_resolution = 0;
+		result->overview_level = -1;
+
+		// Pick the cheapest overview for the requested resolution, only the header of the file is read
+		auto target_param = parameters.find("target_resolution");
+		if (target_param != parameters.end() && !target_param->second.IsNull()) {
+			result->target_resolution = target_param->second.GetValue<double>();
+
+			if (!(result->target_resolution > 0)) {
+				throw InvalidInputException("RT_Read: target_resolution must be positive, got %f",
+				                            result->target_resolution);
+			}
+			auto &config = DBConfig::GetConfig(context);
+			if (!config.options.enable_external_access) {
+				throw PermissionException("Scanning GDAL files is disabled through configuration");
+			}
+			auto dataset = GDALDatasetUniquePtr(OpenFile(context, *result, vector<string>()));
+			result->overview_level = Raster(dataset.get()).GetOverviewLevel(result->target_resolution);
+		}
 		return std::move(result);
 	};
 
@@ -202,25 +285,23 @@ struct RT_Read {
 			throw PermissionException("Scanning GDAL files is disabled through configuration");
 		}
 
-		// First scan for "options" parameter
-		auto gdal_open_options = GDALDatasetFactory::FromNamedParameters(bind_data.parameters, "open_options");
-
-		auto gdal_allowed_drivers = GDALDatasetFactory::FromNamedParameters(bind_data.parameters, "allowed_drivers");
+		vector<string> extra_options;
 
-		auto gdal_sibling_files = GDALDatasetFactory::FromNamedParameters(bind_data.parameters, "sibling_files");
+		// Multi-threaded block decoding
+		auto num_threads_param = bind_data.parameters.find("num_threads");
+		if (num_threads_param != bind_data.parameters.end() && !num_threads_param->second.IsNull()) {
+			extra_options.push_back(
+			    GDALDatasetFactory::GetNumThreadsOption(context, num_threads_param->second.GetValue<int64_t>()));
+		}
+		// Read the overview selected for the target resolution instead of the full resolution
+		if (bind_data.overview_level >= 0) {
+			extra_options.push_back(StringUtil::Format("OVERVIEW_LEVEL=%d", bind_data.overview_level));
+		}
 
 		// Now we can open the dataset
 		auto raw_file_name = bind_data.file_name;
 		auto &ctx_state = GDALClientContextState::GetOrCreate(context);
-		auto dataset = GDALDataset::Open(raw_file_name.c_str(), GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR,
-		                                 gdal_allowed_drivers.empty() ? nullptr : gdal_allowed_drivers.data(),
-		                                 gdal_open_options.empty() ? nullptr : gdal_open_options.data(),
-		                                 gdal_sibling_files.empty() ? nullptr : gdal_sibling_files.data());
-
-		if (dataset == nullptr) {
-			auto error = Raster::GetLastErrorMsg();
-			throw IOException("Could not open file: " + raw_file_name + " (" + error + ")");
-		}
+		auto dataset = OpenFile(context, bind_data, extra_options);
 
 		// Now we can bind the dataset
 		ctx_state.GetDatasetRegistry(context).RegisterDataset(dataset);
@@ -245,6 +326,18 @@ struct RT_Read {
 		return result;
 	}
 
+	//------------------------------------------------------------------------------------------------------------------
+	// To String
+	//------------------------------------------------------------------------------------------------------------------
+
+	static InsertionOrderPreservingMap<string> ToString(TableFunctionToStringInput &input) {
+		InsertionOrderPreservingMap<string> result;
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		result["File"] = bind_data.file_name;
+		AddOverviewInfo(result, bind_data.target_resolution, bind_data.overview_level);
+		return result;
+	}
+
 	//------------------------------------------------------------------------------------------------------------------
 	// Replacement Scan
 	//------------------------------------------------------------------------------------------------------------------
@@ -287,8 +380,12 @@ struct RT_Read {
 	    | `open_options` | VARCHAR[] | A list of key-value pairs that are passed to the GDAL driver to control the opening of the file. |
 	    | `allowed_drivers` | VARCHAR[] | A list of GDAL driver names that are allowed to be used to open the file. If empty, all drivers are allowed. |
 	    | `sibling_files` | VARCHAR[] | A list of sibling files that are required to open the file. |
+	    | `num_threads` | INTEGER | The number of threads used to decode compressed blocks of the file, 0 means all threads. Capped to the DuckDB `threads` setting. |
+	    | `target_resolution` | DOUBLE | The coarsest pixel size (in the units of the coordinate system of the file) that is good enough for the query. The raster is read from the coarsest internal or external (.ovr) overview whose pixel size does not exceed it, or at full resolution if there is none. |
+
+	    Note that GDAL is single-threaded, so this table function will not be able to make full use of parallelism. For a single large compressed file (e.g. a DEFLATE, ZSTD or LERC GeoTIFF), set `num_threads` to decode its blocks in parallel; the option is supported by the GeoTIFF and COG drivers.
 
-	    Note that GDAL is single-threaded, so this table function will not be able to make full use of parallelism.
+	    For previews or downsampled statistics of large files (e.g. a COG), set `target_resolution` so that only the blocks of a matching overview are read. The selected overview level is shown by `EXPLAIN` and in the profiling output.
 
 	    By using `RT_Read`, the spatial extension also provides “replacement scans” for common geospatial file formats, allowing you to query files of these formats as if they were tables directly.
 
@@ -310,6 +407,9 @@ struct RT_Read {
 	static constexpr auto EXAMPLE = R"(
 		-- Read a Gtiff file
 		SELECT * FROM RT_Read('some/file/path/filename.tif');
+
+		-- Read the coarsest overview of a COG with pixels of at most 100m
+		SELECT * FROM RT_Read('some/file/path/filename.tif', target_resolution => 100);
 	)";
 
 	//------------------------------------------------------------------------------------------------------------------
@@ -320,9 +420,12 @@ struct RT_Read {
 		TableFunction func("RT_Read", {LogicalType::VARCHAR}, Execute, Bind);
 
 		func.cardinality = Cardinality;
+		func.to_string = ToString;
 		func.named_parameters["open_options"] = LogicalType::LIST(LogicalType::VARCHAR);
 		func.named_parameters["allowed_drivers"] = LogicalType::LIST(LogicalType::VARCHAR);
 		func.named_parameters["sibling_files"] = LogicalType::LIST(LogicalType::VARCHAR);
+		func.named_parameters["num_threads"] = LogicalType::INTEGER;
+		func.named_parameters["target_resolution"] = LogicalType::DOUBLE;
 		ExtensionUtil::RegisterFunction(db, func);
 
 		FunctionBuilder::AddTableFunctionDocs(db, "RT_Read", DOCUMENTATION, EXAMPLE, {{"ext", "spatial_raster"}});
@@ -333,6 +436,2386 @@ struct RT_Read {
 	}
 };
 
+//======================================================================================================================
+// RT_ReadStack
+//======================================================================================================================
+
+struct RT_ReadStack {
+
+	//! Maximum size of the values of a block of all files buffered by a thread, blocks are split to stay below it
+	static constexpr idx_t BLOCK_BUFFER_SIZE = 16 * 1024 * 1024;
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Bind
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct BindData final : TableFunctionData {
+		vector<string> file_names;
+		vector<string> allowed_drivers;
+		vector<string> open_options;
+		int band_number;
+		int cols;
+		int rows;
+		vector<RasterWindow> blocks;
+		vector<bool> has_nodata;
+		vector<double> nodata_values;
+		//! The requested pixel size (0 when not set) and the overview level read for it, -1 is the full resolution
+		double target_resolution;
+		int overview_level;
+		//! The number of threads decoding the blocks of each file, 0 when not set
+		idx_t decoding_threads;
+		//! The driver tried first to open the files, learnt from previous files of the same kind
+		string driver_hint;
+	};
+
+	static GDALDataset *OpenFile(ClientContext &context, const string &file_name, const BindData &bind_data) {
+		auto dataset =
+		    GDALDatasetFactory::FromFile(context, file_name, bind_data.allowed_drivers, bind_data.open_options);
+
+		if (dataset == nullptr) {
+			auto error = Raster::GetLastErrorMsg();
+			throw IOException("Could not open file: " + file_name + " (" + error + ")");
+		}
+		return dataset;
+	}
+
+	//! Splits the tiles of the rasters in rows (and columns for very wide rows), so the values of a block of all files
+	//! fit in the buffer of a thread
+	static vector<RasterWindow> SplitBlocks(const vector<RasterWindow> &tiles, idx_t file_count) {
+		auto max_pixels = MaxValue<idx_t>(1, BLOCK_BUFFER_SIZE / (file_count * sizeof(double)));
+		vector<RasterWindow> blocks;
+
+		for (auto &tile : tiles) {
+			auto block_x = static_cast<int>(MinValue<idx_t>(tile.x_size, max_pixels));
+			auto block_y = static_cast<int>(MinValue<idx_t>(tile.y_size, MaxValue<idx_t>(1, max_pixels / block_x)));
+
+			for (int y = 0; y < tile.y_size; y += block_y) {
+				for (int x = 0; x < tile.x_size; x += block_x) {
+					blocks.emplace_back(tile.x_off + x, tile.y_off + y, MinValue(block_x, tile.x_size - x),
+					                    MinValue(block_y, tile.y_size - y));
+				}
+			}
+		}
+		return blocks;
+	}
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
+		return_types.emplace_back(LogicalType::INTEGER);
+		return_types.emplace_back(LogicalType::INTEGER);
+		return_types.emplace_back(LogicalType::LIST(LogicalType::DOUBLE));
+		names.emplace_back("col");
+		names.emplace_back("row");
+		names.emplace_back("values");
+
+		auto &config = DBConfig::GetConfig(context);
+		if (!config.options.enable_external_access) {
+			throw PermissionException("Scanning GDAL files is disabled through configuration");
+		}
+
+		auto result = make_uniq<BindData>();
+		result->band_number = 1;
+		result->target_resolution = 0;
+		result->overview_level = -1;
+		result->decoding_threads = 0;
+		bool has_num_threads = false;
+		int64_t num_threads = 0;
+
+		if (input.inputs[0].IsNull()) {
+			throw InvalidInputException("RT_ReadStack: the list of files can not be NULL");
+		}
+		for (auto &file_name : ListValue::GetChildren(input.inputs[0])) {
+			if (file_name.IsNull()) {
+				throw InvalidInputException("RT_ReadStack: the list of files can not contain NULL values");
+			}
+			result->file_names.push_back(file_name.GetValue<string>());
+		}
+		if (result->file_names.empty()) {
+			throw InvalidInputException("RT_ReadStack: the list of files can not be empty");
+		}
+
+		for (auto &kv : input.named_parameters) {
+			if (kv.first == "band") {
+				result->band_number = kv.second.GetValue<int32_t>();
+			} else if (kv.first == "num_threads") {
+				has_num_threads = true;
+				num_threads = kv.second.GetValue<int64_t>();
+			} else if (kv.first == "target_resolution") {
+				result->target_resolution = kv.second.GetValue<double>();
+
+				if (!(result->target_resolution > 0)) {
+					throw InvalidInputException("RT_ReadStack: target_resolution must be positive, got %f",
+					                            result->target_resolution);
+				}
+			} else if (kv.first == "allowed_drivers" || kv.first == "open_options") {
+				auto &target = kv.first == "allowed_drivers" ? result->allowed_drivers : result->open_options;
+				for (auto &item : ListValue::GetChildren(kv.second)) {
+					target.push_back(item.GetValue<string>());
+				}
+			}
+		}
+
+		if (result->allowed_drivers.empty()) {
+			result->driver_hint = GDALDatasetFactory::GetDriverHint(context, result->file_names[0]);
+		}
+
+		// All rasters share the same grid, so the overview level is selected from the first one
+		if (result->target_resolution > 0) {
+			auto dataset = GDALDatasetUniquePtr(OpenFile(context, result->file_names[0], *result));
+			result->overview_level = Raster(dataset.get()).GetOverviewLevel(result->target_resolution);
+
+			if (result->overview_level >= 0) {
+				result->open_options.push_back(StringUtil::Format("OVERVIEW_LEVEL=%d", result->overview_level));
+			}
+		}
+
+		// All rasters must share the same grid, the blocks are taken from the first one
+		GDALDatasetUniquePtr first_dataset;
+
+		for (idx_t i = 0; i < result->file_names.size(); i++) {
+			auto &file_name = result->file_names[i];
+			auto dataset = GDALDatasetUniquePtr(OpenFile(context, file_name, *result));
+
+			if (i == 0) {
+				result->cols = dataset->GetRasterXSize();
+				result->rows = dataset->GetRasterYSize();
+			} else if (dataset->GetRasterXSize() != result->cols || dataset->GetRasterYSize() != result->rows) {
+				throw InvalidInputException("RT_ReadStack: all rasters must have the same size, '%s' is %dx%d but '%s' "
+				                            "is %dx%d",
+				                            file_name, dataset->GetRasterXSize(), dataset->GetRasterYSize(),
+				                            result->file_names[0], result->cols, result->rows);
+			} else if (!Raster(first_dataset.get()).HasSameGrid(dataset.get())) {
+				throw InvalidInputException("RT_ReadStack: all rasters must have the same grid, '%s' has a different "
+				                            "geotransform or coordinate system than '%s'",
+				                            file_name, result->file_names[0]);
+			}
+			if (result->band_number < 1 || result->band_number > dataset->GetRasterCount()) {
+				throw InvalidInputException("Band %d out of range, the raster '%s' has %d bands", result->band_number,
+				                            file_name, dataset->GetRasterCount());
+			}
+			if (i == 0) {
+				result->blocks = SplitBlocks(Raster(dataset.get()).GetTiles(result->band_number),
+				                             result->file_names.size());
+			}
+
+			int has_nodata = FALSE;
+			auto nodata_value = dataset->GetRasterBand(result->band_number)->GetNoDataValue(&has_nodata);
+			result->has_nodata.push_back(has_nodata != FALSE);
+			result->nodata_values.push_back(nodata_value);
+
+			if (i == 0) {
+				first_dataset = std::move(dataset);
+			}
+		}
+
+		// Blocks are already read in parallel by up to one reader per block, decoding threads share what is left of
+		// the thread budget (e.g. all of it for a file of a single block)
+		if (has_num_threads) {
+			auto &scheduler = TaskScheduler::GetScheduler(context);
+			auto thread_count = MaxValue<idx_t>(1, NumericCast<idx_t>(scheduler.NumberOfThreads()));
+			auto reader_count = MaxValue<idx_t>(1, MinValue<idx_t>(thread_count, result->blocks.size()));
+			result->decoding_threads = GDALDatasetFactory::GetNumThreads(context, num_threads, reader_count);
+			result->open_options.push_back(StringUtil::Format("NUM_THREADS=%llu", result->decoding_threads));
+		}
+
+		return std::move(result);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Init Global
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct GlobalState final : GlobalTableFunctionState {
+		atomic<idx_t> next_block;
+		idx_t max_threads;
+
+		explicit GlobalState(idx_t max_threads) : next_block(0), max_threads(max_threads) {
+		}
+
+		idx_t MaxThreads() const override {
+			return max_threads;
+		}
+	};
+
+	static unique_ptr<GlobalTableFunctionState> InitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		return make_uniq_base<GlobalTableFunctionState, GlobalState>(MaxValue<idx_t>(1, bind_data.blocks.size()));
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Init Local
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct LocalState final : LocalTableFunctionState {
+		//! The own handles of the files of this thread, opened on first use
+		vector<GDALDatasetUniquePtr> datasets;
+		//! The current block and the pixels of all files in file-major order
+		RasterWindow block;
+		vector<double> file_values;
+		idx_t pixel_idx;
+		idx_t pixel_count;
+
+		explicit LocalState() : pixel_idx(0), pixel_count(0) {
+		}
+	};
+
+	static unique_ptr<LocalTableFunctionState> InitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+	                                                     GlobalTableFunctionState *global_state) {
+		return make_uniq_base<LocalTableFunctionState, LocalState>();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Read
+	//------------------------------------------------------------------------------------------------------------------
+
+	//! Reads the same block of all files, NODATA pixels are set to NaN.
+	static void ReadBlock(ClientContext &context, const BindData &bind_data, LocalState &state,
+	                      const RasterWindow &block) {
+		auto file_count = bind_data.file_names.size();
+		auto pixel_count = static_cast<idx_t>(block.x_size) * block.y_size;
+
+		if (state.datasets.empty()) {
+			for (auto &file_name : bind_data.file_names) {
+				state.datasets.emplace_back(OpenFile(context, file_name, bind_data));
+			}
+		}
+
+		state.file_values.resize(file_count * pixel_count);
+
+		for (idx_t f = 0; f < file_count; f++) {
+			auto band = state.datasets[f]->GetRasterBand(bind_data.band_number);
+			auto buffer = state.file_values.data() + f * pixel_count;
+
+			if (band->RasterIO(GF_Read, block.x_off, block.y_off, block.x_size, block.y_size, buffer, block.x_size,
+			                   block.y_size, GDT_Float64, 0, 0) != CE_None) {
+				throw IOException("Could not read raster window (%d, %d, %d, %d) of '%s'", block.x_off, block.y_off,
+				                  block.x_size, block.y_size, bind_data.file_names[f]);
+			}
+			if (bind_data.has_nodata[f]) {
+				const double nodata_value = bind_data.nodata_values[f];
+				const double nan_value = std::numeric_limits<double>::quiet_NaN();
+				for (idx_t p = 0; p < pixel_count; p++) {
+					buffer[p] = buffer[p] == nodata_value ? nan_value : buffer[p];
+				}
+			}
+		}
+
+		state.block = block;
+		state.pixel_idx = 0;
+		state.pixel_count = pixel_count;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Execute
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void Execute(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		auto &gstate = input.global_state->Cast<GlobalState>();
+		auto &state = input.local_state->Cast<LocalState>();
+		auto file_count = bind_data.file_names.size();
+
+		if (state.pixel_idx >= state.pixel_count) {
+			auto block_idx = gstate.next_block++;
+			if (block_idx >= bind_data.blocks.size()) {
+				output.SetCardinality(0);
+				return;
+			}
+			ReadBlock(context, bind_data, state, bind_data.blocks[block_idx]);
+		}
+
+		auto count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, state.pixel_count - state.pixel_idx);
+		auto col_data = FlatVector::GetData<int32_t>(output.data[0]);
+		auto row_data = FlatVector::GetData<int32_t>(output.data[1]);
+		auto &values_vector = output.data[2];
+
+		ListVector::Reserve(values_vector, count * file_count);
+		auto list_data = FlatVector::GetData<list_entry_t>(values_vector);
+		auto &child_vector = ListVector::GetEntry(values_vector);
+		auto child_data = FlatVector::GetData<double>(child_vector);
+		auto &child_validity = FlatVector::Validity(child_vector);
+
+		auto &block = state.block;
+
+		for (idx_t i = 0; i < count; i++) {
+			auto p = static_cast<int>(state.pixel_idx + i);
+			col_data[i] = block.x_off + p % block.x_size;
+			row_data[i] = block.y_off + p / block.x_size;
+			list_data[i].offset = i * file_count;
+			list_data[i].length = file_count;
+		}
+
+		// The values of a file are contiguous, they are scattered into the lists with a stride of the file count
+		for (idx_t f = 0; f < file_count; f++) {
+			auto source = state.file_values.data() + f * state.pixel_count + state.pixel_idx;
+
+			for (idx_t i = 0; i < count; i++) {
+				auto child_idx = i * file_count + f;
+				child_data[child_idx] = source[i];
+				if (std::isnan(source[i])) {
+					child_validity.SetInvalid(child_idx);
+				}
+			}
+		}
+		ListVector::SetListSize(values_vector, count * file_count);
+
+		state.pixel_idx += count;
+		output.SetCardinality(count);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Cardinality
+	//------------------------------------------------------------------------------------------------------------------
+
+	static unique_ptr<NodeStatistics> Cardinality(ClientContext &context, const FunctionData *data) {
+		auto &bind_data = data->Cast<BindData>();
+		auto pixel_count = static_cast<idx_t>(bind_data.cols) * bind_data.rows;
+		return make_uniq<NodeStatistics>(pixel_count, pixel_count);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// To String
+	//------------------------------------------------------------------------------------------------------------------
+
+	static InsertionOrderPreservingMap<string> ToString(TableFunctionToStringInput &input) {
+		InsertionOrderPreservingMap<string> result;
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		result["Files"] = std::to_string(bind_data.file_names.size());
+		result["Blocks"] = std::to_string(bind_data.blocks.size());
+		if (bind_data.decoding_threads > 0) {
+			result["Decoding Threads"] = std::to_string(bind_data.decoding_threads);
+		}
+		if (!bind_data.driver_hint.empty()) {
+			result["Driver Hint"] = bind_data.driver_hint;
+		}
+		AddOverviewInfo(result, bind_data.target_resolution, bind_data.overview_level);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Documentation
+	//------------------------------------------------------------------------------------------------------------------
+
+	static constexpr auto DOCUMENTATION = R"(
+	    Reads a stack of co-registered rasters (e.g. the scenes of a time series) and returns the values of all rasters for every pixel.
+
+	    The rasters must have the same grid (size, geotransform and coordinate system), they are read together block by block, so the time series of a pixel is built without scanning every file separately and joining them by `(col, row)`. Blocks are read in parallel, each thread uses its own handles of the files. Blocks are made smaller as the number of files grows, so the values buffered by a thread stay around 16 MiB.
+
+	    Each row contains the column and row of a pixel and a list with one value per raster, in the order of the input paths. NODATA values are NULL.
+
+	    | Parameter | Type | Description |
+	    | --------- | -----| ----------- |
+	    | `paths` | VARCHAR[] | The paths to the files to read. Mandatory |
+	    | `band` | INTEGER | The band number (1-based) to read, 1 by default. |
+	    | `open_options` | VARCHAR[] | A list of key-value pairs that are passed to the GDAL driver to control the opening of the files. |
+	    | `allowed_drivers` | VARCHAR[] | A list of GDAL driver names that are allowed to be used to open the files. If empty, all drivers are allowed. |
+	    | `num_threads` | INTEGER | The number of threads used to decode compressed blocks of each file, 0 means all threads. Capped so that all readers together stay within the DuckDB `threads` setting. |
+	    | `target_resolution` | DOUBLE | The coarsest pixel size that is good enough for the query. The files are read from the coarsest overview whose pixel size does not exceed it (selected from the first file, all files must have it), `col` and `row` are then pixels of that overview. |
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		SELECT col, row, values FROM RT_ReadStack(['scene_2022.tif', 'scene_2023.tif', 'scene_2024.tif'], band => 1);
+	)";
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Register
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void Register(DatabaseInstance &db) {
+		TableFunction func("RT_ReadStack", {LogicalType::LIST(LogicalType::VARCHAR)}, Execute, Bind, InitGlobal,
+		                   InitLocal);
+
+		func.cardinality = Cardinality;
+		func.to_string = ToString;
+		func.named_parameters["band"] = LogicalType::INTEGER;
+		func.named_parameters["num_threads"] = LogicalType::INTEGER;
+		func.named_parameters["target_resolution"] = LogicalType::DOUBLE;
+		func.named_parameters["open_options"] = LogicalType::LIST(LogicalType::VARCHAR);
+		func.named_parameters["allowed_drivers"] = LogicalType::LIST(LogicalType::VARCHAR);
+		ExtensionUtil::RegisterFunction(db, func);
+
+		FunctionBuilder::AddTableFunctionDocs(db, "RT_ReadStack", DOCUMENTATION, EXAMPLE,
+		                                      {{"ext", "spatial_raster"}});
+	}
+};
+
+//======================================================================================================================
+// RT_ReadMultiDim
+//======================================================================================================================
+
+struct RT_ReadMultiDim {
+
+	//! A dimension of the array, with the values of its indexing variable and the range of indexes to read
+	struct Dimension {
+		string name;
+		idx_t size;
+		idx_t block_size;
+		vector<double> coordinates;
+		idx_t min_idx;
+		idx_t max_idx;
+	};
+
+	//! A hyper-rectangle of the array to read
+	struct Chunk {
+		vector<GUInt64> start;
+		vector<size_t> count;
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Bind
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct BindData final : TableFunctionData {
+		string file_name;
+		string variable_name;
+		vector<string> allowed_drivers;
+		vector<string> open_options;
+		vector<Dimension> dimensions;
+		bool empty;
+	};
+
+	static GDALDataset *OpenFile(ClientContext &context, const BindData &bind_data) {
+		auto gdal_allowed_drivers = GDALDatasetFactory::FromVectorOfStrings(bind_data.allowed_drivers);
+		auto gdal_open_options = GDALDatasetFactory::FromVectorOfStrings(bind_data.open_options);
+
+		auto dataset = GDALDatasetFactory::Open(context, bind_data.file_name,
+		                                        gdal_allowed_drivers.empty() ? nullptr : gdal_allowed_drivers.data(),
+		                                        gdal_open_options.empty() ? nullptr : gdal_open_options.data(), nullptr,
+		                                        GDAL_OF_MULTIDIM_RASTER);
+		if (dataset == nullptr) {
+			auto error = Raster::GetLastErrorMsg();
+			throw IOException("Could not open file: " + bind_data.file_name + " (" + error + ")");
+		}
+		return dataset;
+	}
+
+	static std::shared_ptr<GDALMDArray> OpenArray(GDALDataset *dataset, const string &variable_name) {
+		auto root_group = dataset->GetRootGroup();
+		if (!root_group) {
+			throw IOException("The file has no multidimensional arrays");
+		}
+		auto array = StringUtil::StartsWith(variable_name, "/") ? root_group->OpenMDArrayFromFullname(variable_name)
+		                                                         : root_group->OpenMDArray(variable_name);
+		if (!array) {
+			throw InvalidInputException("Variable '%s' not found", variable_name);
+		}
+		return array;
+	}
+
+	//! Returns the array of the root group with the largest number of dimensions, skipping indexing variables
+	static string GetDefaultVariable(GDALDataset *dataset) {
+		auto root_group = dataset->GetRootGroup();
+		string result;
+		idx_t result_dims = 0;
+
+		for (auto &name : root_group ? root_group->GetMDArrayNames() : std::vector<std::string>()) {
+			auto array = root_group->OpenMDArray(name);
+			auto dims = array ? array->GetDimensionCount() : 0;
+			if (dims == 1 && array->GetDimensions()[0]->GetName() == name) {
+				continue;
+			}
+			if (dims > result_dims) {
+				result = name;
+				result_dims = dims;
+			}
+		}
+		if (result.empty()) {
+			throw InvalidInputException("The file has no multidimensional arrays");
+		}
+		return result;
+	}
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
+		auto &config = DBConfig::GetConfig(context);
+		if (!config.options.enable_external_access) {
+			throw PermissionException("Scanning GDAL files is disabled through configuration");
+		}
+
+		auto result = make_uniq<BindData>();
+		result->file_name = input.inputs[0].GetValue<string>();
+		result->empty = false;
+
+		for (auto &kv : input.named_parameters) {
+			if (kv.first == "variable") {
+				result->variable_name = kv.second.GetValue<string>();
+			} else if (kv.first == "allowed_drivers" || kv.first == "open_options") {
+				auto &target = kv.first == "allowed_drivers" ? result->allowed_drivers : result->open_options;
+				for (auto &item : ListValue::GetChildren(kv.second)) {
+					target.push_back(item.GetValue<string>());
+				}
+			}
+		}
+
+		auto dataset = GDALDatasetUniquePtr(OpenFile(context, *result));
+		if (result->variable_name.empty()) {
+			result->variable_name = GetDefaultVariable(dataset.get());
+		}
+		auto array = OpenArray(dataset.get(), result->variable_name);
+
+		if (array->GetDataType().GetClass() != GEDTC_NUMERIC) {
+			throw InvalidInputException("Variable '%s' is not numeric", result->variable_name);
+		}
+
+		// One column per dimension with the coordinates of the element, and the value
+		auto block_size = array->GetBlockSize();
+
+		for (idx_t i = 0; i < array->GetDimensionCount(); i++) {
+			auto &gdal_dimension = array->GetDimensions()[i];
+
+			Dimension dimension;
+			dimension.name = gdal_dimension->GetName();
+			dimension.size = NumericCast<idx_t>(gdal_dimension->GetSize());
+			dimension.min_idx = 0;
+			dimension.max_idx = dimension.size ? dimension.size - 1 : 0;
+			result->empty |= dimension.size == 0;
+
+			// Unknown block sizes, read planes of at most 256x256 elements of the two fastest varying dimensions
+			dimension.block_size = i < block_size.size() ? NumericCast<idx_t>(block_size[i]) : 0;
+			if (dimension.block_size == 0) {
+				dimension.block_size = i + 2 >= array->GetDimensionCount() ? MinValue<idx_t>(dimension.size, 256) : 1;
+			}
+			dimension.block_size = MaxValue<idx_t>(1, dimension.block_size);
+
+			// The coordinates are the values of the indexing variable, or the indexes when there is not
+			auto indexing_variable = gdal_dimension->GetIndexingVariable();
+			dimension.coordinates.resize(dimension.size);
+
+			if (indexing_variable && indexing_variable->GetDimensionCount() == 1 && dimension.size > 0) {
+				const GUInt64 start[] = {0};
+				const size_t count[] = {static_cast<size_t>(dimension.size)};
+				if (!indexing_variable->Read(start, count, nullptr, nullptr, GDALExtendedDataType::Create(GDT_Float64),
+				                             dimension.coordinates.data())) {
+					throw IOException("Could not read the coordinates of dimension '%s'", dimension.name);
+				}
+			} else {
+				for (idx_t j = 0; j < dimension.size; j++) {
+					dimension.coordinates[j] = static_cast<double>(j);
+				}
+			}
+
+			return_types.emplace_back(LogicalType::DOUBLE);
+			names.emplace_back(dimension.name);
+			result->dimensions.push_back(std::move(dimension));
+		}
+
+		return_types.emplace_back(LogicalType::DOUBLE);
+		names.emplace_back(array->GetName());
+
+		return std::move(result);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Filter Pushdown
+	//------------------------------------------------------------------------------------------------------------------
+
+	//! Narrows the range of indexes of a dimension to the coordinates in [min_value, max_value]
+	static void SliceDimension(BindData &bind_data, Dimension &dimension, double min_value, double max_value) {
+		idx_t min_idx = dimension.size;
+		idx_t max_idx = 0;
+
+		for (idx_t i = dimension.min_idx; i <= dimension.max_idx && i < dimension.size; i++) {
+			auto coordinate = dimension.coordinates[i];
+			if (coordinate >= min_value && coordinate <= max_value) {
+				min_idx = MinValue(min_idx, i);
+				max_idx = MaxValue(max_idx, i);
+			}
+		}
+		if (min_idx > max_idx) {
+			bind_data.empty = true;
+			return;
+		}
+		dimension.min_idx = min_idx;
+		dimension.max_idx = max_idx;
+	}
+
+	//! Returns the dimension referenced by an expression, or nullptr if it is not a dimension column
+	static Dimension *GetDimension(LogicalGet &get, BindData &bind_data, const Expression &expr) {
+		if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+			return nullptr;
+		}
+		auto &colref = expr.Cast<BoundColumnRefExpression>();
+		auto &column_ids = get.GetColumnIds();
+
+		if (colref.binding.table_index != get.table_index || colref.binding.column_index >= column_ids.size()) {
+			return nullptr;
+		}
+		auto &column_index = column_ids[colref.binding.column_index];
+		if (column_index.IsRowIdColumn() || column_index.GetPrimaryIndex() >= bind_data.dimensions.size()) {
+			return nullptr;
+		}
+		return &bind_data.dimensions[column_index.GetPrimaryIndex()];
+	}
+
+	static bool GetConstant(const Expression &expr, double &result) {
+		if (expr.GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+			return false;
+		}
+		auto &value = expr.Cast<BoundConstantExpression>().value;
+		Value double_value;
+		string error;
+		if (value.IsNull() || !value.DefaultTryCastAs(LogicalType::DOUBLE, double_value, &error)) {
+			return false;
+		}
+		result = double_value.GetValue<double>();
+		return !std::isnan(result);
+	}
+
+	//! Reads only the chunks matching the filters on the dimensions, the filters are still applied by DuckDB
+	static void PushdownComplexFilter(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+	                                  vector<unique_ptr<Expression>> &filters) {
+		auto &bind_data = bind_data_p->Cast<BindData>();
+		const double lowest = std::numeric_limits<double>::lowest();
+		const double highest = std::numeric_limits<double>::max();
+
+		for (auto &filter : filters) {
+			if (filter->GetExpressionClass() == ExpressionClass::BOUND_BETWEEN) {
+				auto &between = filter->Cast<BoundBetweenExpression>();
+				auto dimension = GetDimension(get, bind_data, *between.input);
+				double lower, upper;
+				if (dimension && GetConstant(*between.lower, lower) && GetConstant(*between.upper, upper)) {
+					SliceDimension(bind_data, *dimension, lower, upper);
+				}
+				continue;
+			}
+			if (filter->GetExpressionClass() != ExpressionClass::BOUND_COMPARISON) {
+				continue;
+			}
+			auto &comparison = filter->Cast<BoundComparisonExpression>();
+			auto comparison_type = comparison.GetExpressionType();
+			auto dimension = GetDimension(get, bind_data, *comparison.left);
+			double constant;
+
+			if (dimension && GetConstant(*comparison.right, constant)) {
+				// column <op> constant
+			} else if ((dimension = GetDimension(get, bind_data, *comparison.right)) &&
+			           GetConstant(*comparison.left, constant)) {
+				comparison_type = FlipComparisonExpression(comparison_type);
+			} else {
+				continue;
+			}
+
+			switch (comparison_type) {
+			case ExpressionType::COMPARE_EQUAL:
+				SliceDimension(bind_data, *dimension, constant, constant);
+				break;
+			case ExpressionType::COMPARE_GREATERTHAN:
+			case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+				SliceDimension(bind_data, *dimension, constant, highest);
+				break;
+			case ExpressionType::COMPARE_LESSTHAN:
+			case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+				SliceDimension(bind_data, *dimension, lowest, constant);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Init Global
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct GlobalState final : GlobalTableFunctionState {
+		vector<Chunk> chunks;
+		atomic<idx_t> next_chunk;
+
+		explicit GlobalState() : next_chunk(0) {
+		}
+
+		idx_t MaxThreads() const override {
+			return MaxValue<idx_t>(1, chunks.size());
+		}
+	};
+
+	static unique_ptr<GlobalTableFunctionState> InitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		auto result = make_uniq<GlobalState>();
+
+		if (bind_data.empty) {
+			return std::move(result);
+		}
+
+		// The chunks intersecting the slices of all dimensions, clipped to the slices
+		auto dim_count = bind_data.dimensions.size();
+		vector<idx_t> first_block(dim_count);
+		vector<idx_t> last_block(dim_count);
+		vector<idx_t> block(dim_count);
+
+		for (idx_t d = 0; d < dim_count; d++) {
+			auto &dimension = bind_data.dimensions[d];
+			first_block[d] = dimension.min_idx / dimension.block_size;
+			last_block[d] = dimension.max_idx / dimension.block_size;
+			block[d] = first_block[d];
+		}
+
+		while (true) {
+			Chunk chunk;
+			for (idx_t d = 0; d < dim_count; d++) {
+				auto &dimension = bind_data.dimensions[d];
+				auto start = MaxValue(block[d] * dimension.block_size, dimension.min_idx);
+				auto end = MinValue((block[d] + 1) * dimension.block_size - 1, dimension.max_idx);
+				chunk.start.push_back(start);
+				chunk.count.push_back(end - start + 1);
+			}
+			result->chunks.push_back(std::move(chunk));
+
+			// Next block, the last dimension varies fastest
+			idx_t d = dim_count;
+			while (d > 0 && block[d - 1] == last_block[d - 1]) {
+				block[d - 1] = first_block[d - 1];
+				d--;
+			}
+			if (d == 0) {
+				break;
+			}
+			block[d - 1]++;
+		}
+
+		return std::move(result);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Init Local
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct LocalState final : LocalTableFunctionState {
+		//! The own handle of the file of this thread, opened on first use
+		GDALDatasetUniquePtr dataset;
+		std::shared_ptr<GDALMDArray> array;
+		bool has_nodata;
+		double nodata_value;
+		double scale;
+		double offset;
+		//! The current chunk, its values, which of them are NODATA and the indexes of the next element to emit
+		idx_t chunk_idx;
+		vector<double> values;
+		vector<bool> nodata;
+		idx_t value_idx;
+		vector<idx_t> position;
+
+		explicit LocalState()
+		    : has_nodata(false), nodata_value(0), scale(1), offset(0), chunk_idx(0), value_idx(0) {
+		}
+	};
+
+	static unique_ptr<LocalTableFunctionState> InitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+	                                                     GlobalTableFunctionState *global_state) {
+		return make_uniq_base<LocalTableFunctionState, LocalState>();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Execute
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void ReadChunk(ClientContext &context, const BindData &bind_data, LocalState &state, const Chunk &chunk) {
+		if (!state.dataset) {
+			state.dataset = GDALDatasetUniquePtr(OpenFile(context, bind_data));
+			state.array = OpenArray(state.dataset.get(), bind_data.variable_name);
+
+			state.nodata_value = state.array->GetNoDataValueAsDouble(&state.has_nodata);
+			bool has_scale = false, has_offset = false;
+			state.scale = state.array->GetScale(&has_scale);
+			state.offset = state.array->GetOffset(&has_offset);
+			state.scale = has_scale ? state.scale : 1.0;
+			state.offset = has_offset ? state.offset : 0.0;
+		}
+
+		idx_t value_count = 1;
+		for (auto count : chunk.count) {
+			value_count *= count;
+		}
+		state.values.resize(value_count);
+
+		if (!state.array->Read(chunk.start.data(), chunk.count.data(), nullptr, nullptr,
+		                       GDALExtendedDataType::Create(GDT_Float64), state.values.data())) {
+			throw IOException("Could not read a chunk of variable '%s': %s", bind_data.variable_name,
+			                  Raster::GetLastErrorMsg());
+		}
+
+		// Unpack the values, only the declared NODATA value is NULL, NaN values of the variable are kept
+		bool nodata_is_nan = state.has_nodata && std::isnan(state.nodata_value);
+		state.nodata.assign(value_count, false);
+
+		for (idx_t i = 0; i < value_count; i++) {
+			auto &value = state.values[i];
+			if (state.has_nodata && (nodata_is_nan ? std::isnan(value) : value == state.nodata_value)) {
+				state.nodata[i] = true;
+			} else {
+				value = value * state.scale + state.offset;
+			}
+		}
+
+		state.value_idx = 0;
+		state.position.assign(chunk.count.size(), 0);
+	}
+
+	static void Execute(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		auto &gstate = input.global_state->Cast<GlobalState>();
+		auto &state = input.local_state->Cast<LocalState>();
+		auto dim_count = bind_data.dimensions.size();
+
+		if (state.value_idx >= state.values.size()) {
+			state.chunk_idx = gstate.next_chunk++;
+			if (state.chunk_idx >= gstate.chunks.size()) {
+				output.SetCardinality(0);
+				return;
+			}
+			ReadChunk(context, bind_data, state, gstate.chunks[state.chunk_idx]);
+		}
+
+		auto &chunk = gstate.chunks[state.chunk_idx];
+		auto count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, state.values.size() - state.value_idx);
+		auto &value_vector = output.data[dim_count];
+		auto value_data = FlatVector::GetData<double>(value_vector);
+
+		for (idx_t i = 0; i < count; i++) {
+			for (idx_t d = 0; d < dim_count; d++) {
+				auto coordinate_idx = chunk.start[d] + state.position[d];
+				FlatVector::GetData<double>(output.data[d])[i] = bind_data.dimensions[d].coordinates[coordinate_idx];
+			}
+
+			value_data[i] = state.values[state.value_idx];
+			if (state.nodata[state.value_idx]) {
+				FlatVector::SetNull(value_vector, i, true);
+			}
+			state.value_idx++;
+
+			// Next element, the last dimension varies fastest
+			for (idx_t d = dim_count; d > 0; d--) {
+				if (++state.position[d - 1] < chunk.count[d - 1]) {
+					break;
+				}
+				state.position[d - 1] = 0;
+			}
+		}
+		output.SetCardinality(count);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Cardinality
+	//------------------------------------------------------------------------------------------------------------------
+
+	static unique_ptr<NodeStatistics> Cardinality(ClientContext &context, const FunctionData *data) {
+		auto &bind_data = data->Cast<BindData>();
+		idx_t value_count = bind_data.empty ? 0 : 1;
+		for (auto &dimension : bind_data.dimensions) {
+			value_count *= dimension.max_idx - dimension.min_idx + 1;
+		}
+		return make_uniq<NodeStatistics>(value_count, value_count);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// To String
+	//------------------------------------------------------------------------------------------------------------------
+
+	static InsertionOrderPreservingMap<string> ToString(TableFunctionToStringInput &input) {
+		InsertionOrderPreservingMap<string> result;
+		auto &bind_data = input.bind_data->Cast<BindData>();
+
+		// The chunks intersecting the slices left by the filters pushed down
+		idx_t chunk_count = bind_data.empty ? 0 : 1;
+		for (auto &dimension : bind_data.dimensions) {
+			chunk_count *= dimension.max_idx / dimension.block_size - dimension.min_idx / dimension.block_size + 1;
+		}
+		result["Variable"] = bind_data.variable_name;
+		result["Chunks"] = std::to_string(chunk_count);
+		return result;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Replacement Scan
+	//------------------------------------------------------------------------------------------------------------------
+
+	static unique_ptr<TableRef> ReplacementScan(ClientContext &, ReplacementScanInput &input,
+	                                            optional_ptr<ReplacementScanData>) {
+		auto &table_name = input.table_name;
+		auto lower_name = StringUtil::Lower(table_name);
+
+		// Check if the file name ends with some common multidimensional file extensions
+		if (StringUtil::EndsWith(lower_name, ".zarr") || StringUtil::EndsWith(lower_name, ".nc") ||
+		    StringUtil::EndsWith(lower_name, ".nc4")) {
+
+			auto table_function = make_uniq<TableFunctionRef>();
+			vector<unique_ptr<ParsedExpression>> children;
+			children.push_back(make_uniq<ConstantExpression>(Value(table_name)));
+			table_function->function = make_uniq<FunctionExpression>("RT_ReadMultiDim", std::move(children));
+			return std::move(table_function);
+		}
+		// else not something we can replace
+		return nullptr;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Documentation
+	//------------------------------------------------------------------------------------------------------------------
+
+	static constexpr auto DOCUMENTATION = R"(
+	    Reads a variable of a multidimensional raster file (e.g. Zarr or NetCDF) using the multidimensional API of GDAL.
+
+	    Each element of the variable is returned as a row with one column per dimension, with the coordinate of the element in that dimension (the value of the indexing variable of the dimension, or the index when there is not), and the value of the element. Elements equal to the NODATA value of the variable are NULL, other NaN values are returned as NaN. Scale and offset are applied.
+
+	    The variable is read by chunks in parallel. Filters on the dimension columns (`=`, `<`, `<=`, `>`, `>=`, `BETWEEN`) are pushed down, so only the chunks of the requested slices are read, e.g. querying a time range of a variable only reads the chunks of that range.
+
+	    | Parameter | Type | Description |
+	    | --------- | -----| ----------- |
+	    | `path` | VARCHAR | The path to the file to read. Mandatory |
+	    | `variable` | VARCHAR | The name (or full name, e.g. `/group/temp`) of the variable to read. By default the variable of the root group with the most dimensions. |
+	    | `open_options` | VARCHAR[] | A list of key-value pairs that are passed to the GDAL driver to control the opening of the file. |
+	    | `allowed_drivers` | VARCHAR[] | A list of GDAL driver names that are allowed to be used to open the file. If empty, all drivers are allowed. |
+
+	    Note that the supported formats depend on the drivers built into GDAL, see [RT_Drivers](#rt_drivers).
+
+	    The spatial extension also provides “replacement scans” for files ending with `.zarr`, `.nc` and `.nc4`, which read the default variable:
+
+	    ```sql
+	    SELECT * FROM './path/to/some/climate.zarr';
+	    ```
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		SELECT time, y, x, temp FROM RT_ReadMultiDim('some/file/path/climate.zarr', variable => 'temp') WHERE time BETWEEN 10 AND 20;
+	)";
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Register
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void Register(DatabaseInstance &db) {
+		TableFunction func("RT_ReadMultiDim", {LogicalType::VARCHAR}, Execute, Bind, InitGlobal, InitLocal);
+
+		func.cardinality = Cardinality;
+		func.pushdown_complex_filter = PushdownComplexFilter;
+		func.to_string = ToString;
+		func.named_parameters["variable"] = LogicalType::VARCHAR;
+		func.named_parameters["open_options"] = LogicalType::LIST(LogicalType::VARCHAR);
+		func.named_parameters["allowed_drivers"] = LogicalType::LIST(LogicalType::VARCHAR);
+		ExtensionUtil::RegisterFunction(db, func);
+
+		FunctionBuilder::AddTableFunctionDocs(db, "RT_ReadMultiDim", DOCUMENTATION, EXAMPLE,
+		                                      {{"ext", "spatial_raster"}});
+
+		// Replacement scan
+		auto &config = DBConfig::GetConfig(db);
+		config.replacement_scans.emplace_back(ReplacementScan);
+	}
+};
+
+//======================================================================================================================
+// RT_Polygonize
+//======================================================================================================================
+
+struct RT_Polygonize {
+
+	//! A polygon of connected pixels sharing the same value
+	struct PolygonRecord {
+		double value;
+		string wkb;
+	};
+
+	//! A polygon touching an inner border of its tile, which may continue in the neighbour tiles. Its coordinates are
+	//! in pixels of the raster, so the pieces of a polygon split by the tiling share exactly the same edges.
+	struct BorderPiece {
+		double value;
+		unique_ptr<OGRGeometry> geometry;
+		OGREnvelope envelope;
+	};
+
+	//! A raster being polygonized, by batches of rows of tiles from the top of the raster
+	struct PolygonizeJob {
+		GDALDataset *dataset;
+		int band_number;
+		double gt[6];
+		bool all_valid;
+		vector<RasterWindow> tiles;
+		//! The first tile of the next batch
+		idx_t next_tile;
+		//! The pieces touching the lower border of the batches polygonized so far
+		vector<BorderPiece> pending;
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Bind
+	//------------------------------------------------------------------------------------------------------------------
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
+		return_types.emplace_back(LogicalType::DOUBLE);
+		return_types.emplace_back(RasterTypes::WKB_BLOB());
+		names.emplace_back("value");
+		names.emplace_back("geom");
+
+		return make_uniq<TableFunctionData>();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Init Local
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct LocalState final : LocalTableFunctionState {
+		idx_t input_idx;
+		bool active;
+		PolygonizeJob job;
+		//! The polygons completed by the last batch, released as they are output
+		vector<PolygonRecord> records;
+		idx_t record_idx;
+		explicit LocalState() : input_idx(0), active(false), record_idx(0) {
+		}
+	};
+
+	static unique_ptr<LocalTableFunctionState> InitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+	                                                     GlobalTableFunctionState *global_state) {
+		return make_uniq_base<LocalTableFunctionState, LocalState>();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Polygonize
+	//------------------------------------------------------------------------------------------------------------------
+
+	//! Transforms a polygon from pixel coordinates of the raster to its coordinate system
+	static void PixelToWorld(OGRPolygon &polygon, const double gt[6]) {
+		for (auto ring : polygon) {
+			for (int i = 0; i < ring->getNumPoints(); i++) {
+				auto x = ring->getX(i);
+				auto y = ring->getY(i);
+				ring->setPoint(i, gt[0] + x * gt[1] + y * gt[2], gt[3] + x * gt[4] + y * gt[5]);
+			}
+		}
+	}
+
+	static void AddRecord(vector<PolygonRecord> &records, double value, OGRPolygon &polygon, const double gt[6]) {
+		PixelToWorld(polygon, gt);
+
+		PolygonRecord record;
+		record.value = value;
+		record.wkb.resize(polygon.WkbSize());
+		polygon.exportToWkb(wkbNDR, reinterpret_cast<unsigned char *>(&record.wkb[0]), wkbVariantIso);
+		records.push_back(std::move(record));
+	}
+
+	//! Polygonizes one tile in pixel coordinates, polygons touching an inner border of the tile are kept apart to
+	//! stitch them later. Unless all pixels are valid, the mask of the band (NODATA, alpha band or explicit mask) is
+	//! copied with the tile.
+	static void PolygonizeTile(RasterTileReader &reader, const PolygonizeJob &job, const RasterWindow &tile,
+	                           vector<PolygonRecord> &records, vector<BorderPiece> &pieces, mutex &lock) {
+
+		auto source = reader.GetSource();
+		auto cols = source->GetRasterXSize();
+		auto rows = source->GetRasterYSize();
+
+		// Copy the tile into a MEM dataset placed at its offset in the pixel grid of the raster, so the polygons are
+		// in pixel coordinates whatever the geotransform of the raster (rotated or not)
+		auto mem_driver = GetGDALDriverManager()->GetDriverByName("MEM");
+		auto tile_dataset =
+		    GDALDatasetUniquePtr(mem_driver->Create("", tile.x_size, tile.y_size, 1, GDT_Float64, nullptr));
+
+		double tile_gt[6] = {static_cast<double>(tile.x_off), 1, 0, static_cast<double>(tile.y_off), 0, 1};
+		tile_dataset->SetGeoTransform(tile_gt);
+
+		auto tile_band = tile_dataset->GetRasterBand(1);
+
+		vector<double> buffer(static_cast<size_t>(tile.x_size) * tile.y_size);
+		reader.Read(job.band_number, tile, GDT_Float64, buffer.data(), tile.x_size, tile.y_size);
+
+		if (tile_band->RasterIO(GF_Write, 0, 0, tile.x_size, tile.y_size, buffer.data(), tile.x_size, tile.y_size,
+		                        GDT_Float64, 0, 0) != CE_None) {
+			throw IOException("Could not write raster tile: " + Raster::GetLastErrorMsg());
+		}
+
+		GDALRasterBand *mask_band = nullptr;
+		if (!job.all_valid) {
+			vector<uint8_t> mask(static_cast<size_t>(tile.x_size) * tile.y_size);
+			CPLErr err = CE_None;
+
+			reader.Access([&](GDALDataset &dataset) {
+				err = dataset.GetRasterBand(job.band_number)
+				          ->GetMaskBand()
+				          ->RasterIO(GF_Read, tile.x_off, tile.y_off, tile.x_size, tile.y_size, mask.data(),
+				                     tile.x_size, tile.y_size, GDT_Byte, 0, 0);
+			});
+			if (err != CE_None) {
+				throw IOException("Could not read raster mask: " + Raster::GetLastErrorMsg());
+			}
+
+			if (tile_dataset->AddBand(GDT_Byte) != CE_None) {
+				throw IOException("Could not create raster mask: " + Raster::GetLastErrorMsg());
+			}
+			mask_band = tile_dataset->GetRasterBand(2);
+			if (mask_band->RasterIO(GF_Write, 0, 0, tile.x_size, tile.y_size, mask.data(), tile.x_size, tile.y_size,
+			                        GDT_Byte, 0, 0) != CE_None) {
+				throw IOException("Could not write raster mask: " + Raster::GetLastErrorMsg());
+			}
+		}
+
+		// Polygonize the tile into a Memory layer
+		auto ogr_driver = GetGDALDriverManager()->GetDriverByName("Memory");
+		auto vector_dataset = GDALDatasetUniquePtr(ogr_driver->Create("", 0, 0, 0, GDT_Unknown, nullptr));
+		auto layer = vector_dataset->CreateLayer("polygons", nullptr, wkbPolygon, nullptr);
+
+		OGRFieldDefn field("value", OFTReal);
+		layer->CreateField(&field);
+
+		if (GDALFPolygonize(GDALRasterBand::ToHandle(tile_band), GDALRasterBand::ToHandle(mask_band),
+		                    OGRLayer::ToHandle(layer), 0, nullptr, nullptr, nullptr) != CE_None) {
+			throw IOException("Could not polygonize raster tile: " + Raster::GetLastErrorMsg());
+		}
+
+		// Classify the polygons, the ones touching an inner border may continue in the neighbour tiles. Vertices are
+		// on pixel corners, so the comparisons are exact.
+		auto tile_x_a = static_cast<double>(tile.x_off);
+		auto tile_x_b = static_cast<double>(tile.x_off + tile.x_size);
+		auto tile_y_a = static_cast<double>(tile.y_off);
+		auto tile_y_b = static_cast<double>(tile.y_off + tile.y_size);
+
+		bool left_border = tile.x_off > 0;
+		bool right_border = tile.x_off + tile.x_size < cols;
+		bool upper_border = tile.y_off > 0;
+		bool lower_border = tile.y_off + tile.y_size < rows;
+
+		vector<PolygonRecord> tile_records;
+		vector<BorderPiece> tile_pieces;
+
+		layer->ResetReading();
+		OGRFeature *feature;
+
+		while ((feature = layer->GetNextFeature()) != nullptr) {
+			OGRFeatureUniquePtr feature_ptr(feature);
+			auto value = feature->GetFieldAsDouble(0);
+			auto geometry = unique_ptr<OGRGeometry>(feature->StealGeometry());
+
+			if (!geometry || wkbFlatten(geometry->getGeometryType()) != wkbPolygon) {
+				continue;
+			}
+
+			OGREnvelope env;
+			geometry->getEnvelope(&env);
+
+			bool on_border = (left_border && env.MinX <= tile_x_a) || (right_border && env.MaxX >= tile_x_b) ||
+			                 (upper_border && env.MinY <= tile_y_a) || (lower_border && env.MaxY >= tile_y_b);
+
+			if (on_border) {
+				BorderPiece piece;
+				piece.value = value;
+				piece.geometry = std::move(geometry);
+				piece.envelope = env;
+				tile_pieces.push_back(std::move(piece));
+			} else {
+				AddRecord(tile_records, value, *geometry->toPolygon(), job.gt);
+			}
+		}
+
+		lock_guard<mutex> guard(lock);
+		for (auto &record : tile_records) {
+			records.push_back(std::move(record));
+		}
+		for (auto &piece : tile_pieces) {
+			pieces.push_back(std::move(piece));
+		}
+	}
+
+	//! Merges the pieces of a connected component of polygons of a same value. The resulting polygons touching the
+	//! lower border of the batches polygonized so far stay pending, the others are complete.
+	static void StitchPieces(const PolygonizeJob &job, vector<BorderPiece> &pieces, const vector<idx_t> &component,
+	                         int y_end, vector<PolygonRecord> &records, vector<BorderPiece> &pending, mutex &lock) {
+		auto value = pieces[component[0]].value;
+		auto rows = job.dataset->GetRasterYSize();
+
+		unique_ptr<OGRGeometry> merged;
+		if (component.size() == 1) {
+			merged = std::move(pieces[component[0]].geometry);
+		} else {
+			OGRMultiPolygon collection;
+			for (auto piece_idx : component) {
+				collection.addGeometryDirectly(pieces[piece_idx].geometry.release());
+			}
+			merged = unique_ptr<OGRGeometry>(collection.UnionCascaded());
+			if (!merged) {
+				throw InternalException("Could not stitch polygons: " + Raster::GetLastErrorMsg());
+			}
+		}
+
+		vector<unique_ptr<OGRGeometry>> parts;
+		if (OGR_GT_IsSubClassOf(merged->getGeometryType(), wkbGeometryCollection)) {
+			auto collection = merged->toGeometryCollection();
+			for (int i = 0; i < collection->getNumGeometries(); i++) {
+				parts.emplace_back(collection->getGeometryRef(i)->clone());
+			}
+		} else {
+			parts.push_back(std::move(merged));
+		}
+
+		vector<PolygonRecord> stitched_records;
+		vector<BorderPiece> stitched_pieces;
+
+		for (auto &part : parts) {
+			if (wkbFlatten(part->getGeometryType()) != wkbPolygon) {
+				continue;
+			}
+			OGREnvelope env;
+			part->getEnvelope(&env);
+
+			if (y_end < rows && env.MaxY >= static_cast<double>(y_end)) {
+				BorderPiece piece;
+				piece.value = value;
+				piece.geometry = std::move(part);
+				piece.envelope = env;
+				stitched_pieces.push_back(std::move(piece));
+			} else {
+				AddRecord(stitched_records, value, *part->toPolygon(), job.gt);
+			}
+		}
+
+		lock_guard<mutex> guard(lock);
+		for (auto &record : stitched_records) {
+			records.push_back(std::move(record));
+		}
+		for (auto &piece : stitched_pieces) {
+			pending.push_back(std::move(piece));
+		}
+	}
+
+	//! Groups pieces of a same value whose envelopes touch or overlap, the pieces of a polygon split by the tiling
+	//! always end up in the same group
+	static vector<vector<idx_t>> GetConnectedPieces(vector<BorderPiece> &pieces) {
+		std::sort(pieces.begin(), pieces.end(), [](const BorderPiece &a, const BorderPiece &b) {
+			return a.value < b.value || (a.value == b.value && a.envelope.MinX < b.envelope.MinX);
+		});
+
+		vector<idx_t> parents(pieces.size());
+		for (idx_t i = 0; i < pieces.size(); i++) {
+			parents[i] = i;
+		}
+		auto get_root = [&](idx_t i) {
+			while (parents[i] != i) {
+				parents[i] = parents[parents[i]];
+				i = parents[i];
+			}
+			return i;
+		};
+
+		for (idx_t i = 0; i < pieces.size(); i++) {
+			for (idx_t j = i + 1; j < pieces.size() && pieces[j].value == pieces[i].value &&
+			                      pieces[j].envelope.MinX <= pieces[i].envelope.MaxX;
+			     j++) {
+				if (pieces[i].envelope.Intersects(pieces[j].envelope)) {
+					parents[get_root(j)] = get_root(i);
+				}
+			}
+		}
+
+		vector<vector<idx_t>> components;
+		unordered_map<idx_t, idx_t> component_index;
+		for (idx_t i = 0; i < pieces.size(); i++) {
+			auto root = get_root(i);
+			auto entry = component_index.find(root);
+			if (entry == component_index.end()) {
+				component_index[root] = components.size();
+				components.emplace_back();
+				components.back().push_back(i);
+			} else {
+				components[entry->second].push_back(i);
+			}
+		}
+		return components;
+	}
+
+	static void InitPolygonize(GDALDataset *dataset, int band_number, PolygonizeJob &job) {
+		if (band_number < 1 || band_number > dataset->GetRasterCount()) {
+			throw InvalidInputException("Band %d out of range, the raster has %d bands", band_number,
+			                            dataset->GetRasterCount());
+		}
+
+		Raster raster(dataset);
+		job.dataset = dataset;
+		job.band_number = band_number;
+		raster.GetGeoTransform(job.gt);
+		job.all_valid = dataset->GetRasterBand(band_number)->GetMaskFlags() == GMF_ALL_VALID;
+		job.tiles = raster.GetTiles(band_number);
+		job.next_tile = 0;
+		job.pending.clear();
+	}
+
+	//! Polygonizes the next batch of rows of tiles, at least one per thread, in parallel. The polygons inside the tiles
+	//! are complete, the pieces crossing tile borders are stitched with the pending ones of the previous batches.
+	//! Returns false once all tiles are polygonized.
+	static bool PolygonizeStep(ClientContext &context, PolygonizeJob &job, vector<PolygonRecord> &records) {
+		auto &tiles = job.tiles;
+		if (job.next_tile >= tiles.size()) {
+			return false;
+		}
+
+		auto &scheduler = TaskScheduler::GetScheduler(context);
+		auto thread_count = MaxValue<idx_t>(1, NumericCast<idx_t>(scheduler.NumberOfThreads()));
+
+		auto batch_start = job.next_tile;
+		auto batch_end = batch_start;
+		do {
+			auto row_y = tiles[batch_end].y_off;
+			while (batch_end < tiles.size() && tiles[batch_end].y_off == row_y) {
+				batch_end++;
+			}
+		} while (batch_end < tiles.size() && batch_end - batch_start < thread_count);
+
+		auto y_end = tiles[batch_end - 1].y_off + tiles[batch_end - 1].y_size;
+		job.next_tile = batch_end;
+
+		mutex lock;
+		vector<BorderPiece> pieces;
+		RasterTileExecutor executor(context, job.dataset);
+		executor.Execute(batch_end - batch_start, [&](RasterTileReader &reader, idx_t tile_idx) {
+			PolygonizeTile(reader, job, tiles[batch_start + tile_idx], records, pieces, lock);
+		});
+
+		// Stitch the new pieces with the pending ones, connected components are independent so do it in parallel too
+		for (auto &piece : job.pending) {
+			pieces.push_back(std::move(piece));
+		}
+		job.pending.clear();
+
+		auto components = GetConnectedPieces(pieces);
+		RasterTileExecutor stitcher(context, nullptr);
+		stitcher.Execute(components.size(), [&](RasterTileReader &reader, idx_t component_idx) {
+			StitchPieces(job, pieces, components[component_idx], y_end, records, job.pending, lock);
+		});
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Execute
+	//------------------------------------------------------------------------------------------------------------------
+
+	static OperatorResultType Execute(ExecutionContext &context, TableFunctionInput &data_p, DataChunk &input,
+	                                  DataChunk &output) {
+		auto &state = data_p.local_state->Cast<LocalState>();
+
+		while (state.input_idx < input.size()) {
+			if (!state.active) {
+				auto raster_value = input.data[0].GetValue(state.input_idx);
+				auto band_value = input.data[1].GetValue(state.input_idx);
+
+				if (raster_value.IsNull() || band_value.IsNull()) {
+					state.input_idx++;
+					continue;
+				}
+				auto &raster = reinterpret_cast<RasterValue &>(raster_value);
+				InitPolygonize(raster.get(), band_value.GetValue<int32_t>(), state.job);
+				state.records.clear();
+				state.record_idx = 0;
+				state.active = true;
+			}
+
+			// Polygonize the next batch of tiles once the previous polygons are output
+			if (state.record_idx >= state.records.size()) {
+				state.records.clear();
+				state.record_idx = 0;
+
+				if (!PolygonizeStep(context.client, state.job, state.records)) {
+					state.job.tiles.clear();
+					state.active = false;
+					state.input_idx++;
+				}
+				continue;
+			}
+
+			// And fill the output
+			idx_t count = 0;
+			auto value_data = FlatVector::GetData<double>(output.data[0]);
+			auto geom_data = FlatVector::GetData<string_t>(output.data[1]);
+
+			for (; state.record_idx < state.records.size() && count < STANDARD_VECTOR_SIZE; state.record_idx++) {
+				auto &record = state.records[state.record_idx];
+				value_data[count] = record.value;
+				geom_data[count] = StringVector::AddStringOrBlob(output.data[1], record.wkb);
+				string().swap(record.wkb);
+				count++;
+			}
+			output.SetCardinality(count);
+			return OperatorResultType::HAVE_MORE_OUTPUT;
+		}
+
+		state.input_idx = 0;
+		output.SetCardinality(0);
+		return OperatorResultType::NEED_MORE_INPUT;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Documentation
+	//------------------------------------------------------------------------------------------------------------------
+
+	static constexpr auto DOCUMENTATION = R"(
+	    Creates vector polygons for all connected regions of pixels in a raster band sharing a common pixel value.
+
+	    The raster is split in tiles that are polygonized in parallel by batches of rows of tiles, from the top of the raster. Polygons inside a tile are returned as soon as its batch is done, the pieces of polygons crossing tile borders are stitched with the pieces of the previous batches and returned once complete, so the result is the same as polygonizing the whole raster at once. Pixels masked by the band are ignored: pixels with the NODATA value, or transparent pixels of an alpha band or of a mask.
+
+	    Each polygon is returned as a row with the pixel value and its geometry as a WKB blob, in the coordinate system of the raster. The geometry can be converted to a `GEOMETRY` of the spatial extension with `ST_GeomFromWKB(geom)` or `geom::GEOMETRY`.
+
+	    | Parameter | Type | Description |
+	    | --------- | -----| ----------- |
+	    | `raster` | RASTER | The raster to polygonize. Mandatory |
+	    | `band` | INTEGER | The band number (1-based) to polygonize. Mandatory |
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		SELECT p.value, p.geom FROM RT_Read('some/file/path/filename.tif') r, RT_Polygonize(r.raster, 1) p;
+	)";
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Register
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void Register(DatabaseInstance &db) {
+		TableFunction func("RT_Polygonize", {RasterTypes::RASTER(), LogicalType::INTEGER}, nullptr, Bind, nullptr,
+		                   InitLocal);
+		func.in_out_function = Execute;
+		ExtensionUtil::RegisterFunction(db, func);
+
+		FunctionBuilder::AddTableFunctionDocs(db, "RT_Polygonize", DOCUMENTATION, EXAMPLE,
+		                                      {{"ext", "spatial_raster"}});
+	}
+};
+
+//======================================================================================================================
+// RT_ToTiles
+//======================================================================================================================
+
+struct RT_ToTiles {
+
+	//! Size in pixels of the tiles
+	static constexpr int TILE_SIZE = 256;
+	//! Half of the extent of the Web Mercator (EPSG:3857) world
+	static constexpr double WEB_MERCATOR_HALF_SIZE = 20037508.342789244;
+	//! Maximum number of tiles of the deepest zoom level
+	static constexpr idx_t MAX_TILE_COUNT = 1 << 20;
+	//! Depth of the subtrees of the pyramid generated at once, their up to 64 deepest tiles are warped in parallel
+	static constexpr int SUBTREE_DEPTH = 3;
+
+	//! An encoded tile of the pyramid
+	struct TileRecord {
+		int32_t z;
+		int32_t x;
+		int32_t y;
+		string data;
+	};
+
+	//! A tile of a zoom level, as a MEM dataset with the bands of the source and an alpha band
+	struct PyramidTile {
+		int x;
+		int y;
+		GDALDatasetUniquePtr dataset;
+	};
+
+	//! A tile of the pyramid whose children are being generated, with the children already done
+	struct PyramidNode {
+		int z;
+		int x;
+		int y;
+		//! The next child to visit, children are ordered top-left, top-right, bottom-left and bottom-right
+		int next_child;
+		GDALDatasetUniquePtr children[4];
+
+		PyramidNode(int z, int x, int y) : z(z), x(x), y(y), next_child(0) {
+		}
+	};
+
+	//! The pyramid of a raster being generated depth-first from the tiles of the lowest zoom level. Subtrees of
+	//! SUBTREE_DEPTH levels above the deepest zoom level are generated at once, the tiles above them are built as soon
+	//! as their four children are done. Only the children of the tiles of the current path are held in memory.
+	struct Pyramid {
+		GDALDataset *dataset;
+		int min_zoom;
+		int max_zoom;
+		//! The zoom level of the roots of the subtrees generated at once
+		int subtree_zoom;
+		//! The range of tiles of the deepest zoom level covering the raster
+		int min_tile_x;
+		int min_tile_y;
+		int max_tile_x;
+		int max_tile_y;
+		string format;
+		bool keep_alpha;
+		GDALRIOResampleAlg resample_alg;
+		//! The path from a tile of the lowest zoom level to the tile being generated
+		vector<PyramidNode> path;
+		//! The next tile of the lowest zoom level to generate
+		idx_t next_root;
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Bind
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct BindData final : TableFunctionData {
+		string resampling;
+	};
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
+		return_types.emplace_back(LogicalType::INTEGER);
+		return_types.emplace_back(LogicalType::INTEGER);
+		return_types.emplace_back(LogicalType::INTEGER);
+		return_types.emplace_back(LogicalType::BLOB);
+		names.emplace_back("z");
+		names.emplace_back("x");
+		names.emplace_back("y");
+		names.emplace_back("blob");
+
+		auto result = make_uniq<BindData>();
+		result->resampling = "near";
+
+		auto resampling_param = input.named_parameters.find("resampling");
+		if (resampling_param != input.named_parameters.end()) {
+			result->resampling = StringUtil::Lower(resampling_param->second.GetValue<string>());
+		}
+		GetResampleAlgorithm(result->resampling);
+
+		return std::move(result);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Init Local
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct LocalState final : LocalTableFunctionState {
+		idx_t input_idx;
+		bool active;
+		Pyramid pyramid;
+		//! The encoded tiles generated by the last step of the pyramid, released as they are output
+		vector<TileRecord> records;
+		idx_t record_idx;
+		explicit LocalState() : input_idx(0), active(false), record_idx(0) {
+		}
+	};
+
+	static unique_ptr<LocalTableFunctionState> InitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+	                                                     GlobalTableFunctionState *global_state) {
+		return make_uniq_base<LocalTableFunctionState, LocalState>();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Tiles
+	//------------------------------------------------------------------------------------------------------------------
+
+	static GDALRIOResampleAlg GetResampleAlgorithm(const string &resampling) {
+		if (resampling == "near") {
+			return GRIORA_NearestNeighbour;
+		} else if (resampling == "bilinear") {
+			return GRIORA_Bilinear;
+		} else if (resampling == "cubic") {
+			return GRIORA_Cubic;
+		} else if (resampling == "average") {
+			return GRIORA_Average;
+		} else if (resampling == "mode") {
+			return GRIORA_Mode;
+		}
+		throw InvalidInputException("RT_ToTiles: unsupported resampling '%s', expected one of near, bilinear, cubic, "
+		                            "average or mode",
+		                            resampling);
+	}
+
+	static uint64_t GetTileKey(int x, int y) {
+		return static_cast<uint64_t>(x) << 32 | static_cast<uint32_t>(y);
+	}
+
+	//! Returns the geographic transform of a tile in Web Mercator
+	static void GetTileGeoTransform(int z, int x, int y, double gt[6]) {
+		auto tile_size = 2 * WEB_MERCATOR_HALF_SIZE / static_cast<double>(1 << z);
+		gt[0] = -WEB_MERCATOR_HALF_SIZE + x * tile_size;
+		gt[1] = tile_size / TILE_SIZE;
+		gt[2] = 0;
+		gt[3] = WEB_MERCATOR_HALF_SIZE - y * tile_size;
+		gt[4] = 0;
+		gt[5] = -tile_size / TILE_SIZE;
+	}
+
+	//! Returns the extent of a Raster in Web Mercator, sampling points along its borders
+	static bool GetWebMercatorExtent(GDALDataset *dataset, double &min_x, double &min_y, double &max_x,
+	                                 double &max_y) {
+		OGRSpatialReference target_srs;
+		target_srs.importFromEPSG(3857);
+		target_srs.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+
+		auto transformation = unique_ptr<OGRCoordinateTransformation>(
+		    OGRCreateCoordinateTransformation(dataset->GetSpatialRef(), &target_srs));
+		if (!transformation) {
+			return false;
+		}
+
+		double gt[6];
+		Raster(dataset).GetGeoTransform(gt);
+		const int steps = 20;
+		auto cols = dataset->GetRasterXSize();
+		auto rows = dataset->GetRasterYSize();
+
+		vector<double> xs, ys;
+		for (int i = 0; i <= steps; i++) {
+			double t = static_cast<double>(i) / steps;
+			double px[] = {t * cols, t * cols, 0, static_cast<double>(cols)};
+			double py[] = {0, static_cast<double>(rows), t * rows, t * rows};
+			for (int k = 0; k < 4; k++) {
+				xs.push_back(gt[0] + px[k] * gt[1] + py[k] * gt[2]);
+				ys.push_back(gt[3] + px[k] * gt[4] + py[k] * gt[5]);
+			}
+		}
+
+		vector<int> success(xs.size());
+		transformation->Transform(static_cast<int>(xs.size()), xs.data(), ys.data(), nullptr, success.data());
+
+		min_x = min_y = std::numeric_limits<double>::max();
+		max_x = max_y = std::numeric_limits<double>::lowest();
+		bool valid = false;
+
+		for (idx_t i = 0; i < xs.size(); i++) {
+			if (success[i]) {
+				min_x = MinValue(min_x, xs[i]);
+				min_y = MinValue(min_y, ys[i]);
+				max_x = MaxValue(max_x, xs[i]);
+				max_y = MaxValue(max_y, ys[i]);
+				valid = true;
+			}
+		}
+		return valid;
+	}
+
+	//! Returns true if any pixel of the alpha band of a tile is not transparent
+	static bool HasData(GDALDataset &tile) {
+		vector<uint8_t> alpha(TILE_SIZE * TILE_SIZE);
+		auto band = tile.GetRasterBand(tile.GetRasterCount());
+
+		if (band->RasterIO(GF_Read, 0, 0, TILE_SIZE, TILE_SIZE, alpha.data(), TILE_SIZE, TILE_SIZE, GDT_Byte, 0, 0) !=
+		    CE_None) {
+			throw IOException("Could not read tile: " + Raster::GetLastErrorMsg());
+		}
+		for (auto value : alpha) {
+			if (value != 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//! Warps the source Raster into a tile of the deepest zoom level, returns nullptr if the tile is empty
+	static GDALDataset *WarpTile(GDALDataset &dataset, int z, int x, int y, const string &resampling) {
+		double gt[6];
+		GetTileGeoTransform(z, x, y, gt);
+
+		CPLStringList args;
+		args.AddString("-of");
+		args.AddString("MEM");
+		args.AddString("-t_srs");
+		args.AddString("EPSG:3857");
+		args.AddString("-te");
+		args.AddString(CPLSPrintf("%.17g", gt[0]));
+		args.AddString(CPLSPrintf("%.17g", gt[3] + TILE_SIZE * gt[5]));
+		args.AddString(CPLSPrintf("%.17g", gt[0] + TILE_SIZE * gt[1]));
+		args.AddString(CPLSPrintf("%.17g", gt[3]));
+		args.AddString("-ts");
+		args.AddString(std::to_string(TILE_SIZE).c_str());
+		args.AddString(std::to_string(TILE_SIZE).c_str());
+		args.AddString("-r");
+		args.AddString(resampling.c_str());
+		args.AddString("-dstalpha");
+
+		auto options = GDALWarpAppOptionsNew(args.List(), nullptr);
+		auto source = GDALDataset::ToHandle(&dataset);
+		int usage_error = FALSE;
+		auto result =
+		    GDALDatasetUniquePtr(GDALDataset::FromHandle(GDALWarp("", nullptr, 1, &source, options, &usage_error)));
+		GDALWarpAppOptionsFree(options);
+
+		if (!result) {
+			throw IOException("Could not warp tile %d/%d/%d: %s", z, x, y, Raster::GetLastErrorMsg());
+		}
+		return HasData(*result) ? result.release() : nullptr;
+	}
+
+	//! Builds a tile from its (up to) four children of the next zoom level, ordered top-left, top-right, bottom-left
+	//! and bottom-right. Returns nullptr if the tile is empty.
+	static GDALDataset *DownsampleTile(int z, int x, int y, GDALDataset *const children[4],
+	                                   GDALRIOResampleAlg resample_alg) {
+		GDALDataset *sample = nullptr;
+		for (int i = 0; i < 4; i++) {
+			sample = children[i] ? children[i] : sample;
+		}
+		if (!sample) {
+			return nullptr;
+		}
+		auto band_count = sample->GetRasterCount();
+		auto data_type = sample->GetRasterBand(1)->GetRasterDataType();
+		auto data_size = GDALGetDataTypeSizeBytes(data_type);
+
+		// Mosaic of the children, missing ones are transparent
+		auto driver = GetGDALDriverManager()->GetDriverByName("MEM");
+		auto mosaic =
+		    GDALDatasetUniquePtr(driver->Create("", 2 * TILE_SIZE, 2 * TILE_SIZE, band_count, data_type, nullptr));
+		auto result = GDALDatasetUniquePtr(driver->Create("", TILE_SIZE, TILE_SIZE, band_count, data_type, nullptr));
+		if (!mosaic || !result) {
+			throw IOException("Could not create tile: " + Raster::GetLastErrorMsg());
+		}
+		mosaic->GetRasterBand(band_count)->SetColorInterpretation(GCI_AlphaBand);
+		result->GetRasterBand(band_count)->SetColorInterpretation(GCI_AlphaBand);
+
+		double gt[6];
+		GetTileGeoTransform(z, x, y, gt);
+		result->SetGeoTransform(gt);
+		result->SetSpatialRef(sample->GetSpatialRef());
+
+		vector<uint8_t> buffer(static_cast<size_t>(TILE_SIZE) * TILE_SIZE * data_size);
+
+		for (int i = 0; i < 4; i++) {
+			if (!children[i]) {
+				continue;
+			}
+			auto x_off = (i % 2) * TILE_SIZE;
+			auto y_off = (i / 2) * TILE_SIZE;
+
+			for (int b = 1; b <= band_count; b++) {
+				if (children[i]->GetRasterBand(b)->RasterIO(GF_Read, 0, 0, TILE_SIZE, TILE_SIZE, buffer.data(),
+				                                            TILE_SIZE, TILE_SIZE, data_type, 0, 0) != CE_None ||
+				    mosaic->GetRasterBand(b)->RasterIO(GF_Write, x_off, y_off, TILE_SIZE, TILE_SIZE, buffer.data(),
+				                                       TILE_SIZE, TILE_SIZE, data_type, 0, 0) != CE_None) {
+					throw IOException("Could not build tile %d/%d/%d: %s", z, x, y, Raster::GetLastErrorMsg());
+				}
+			}
+		}
+
+		// GDAL only uses an alpha band as the mask of 8-bit bands, so the alpha band is copied into an explicit mask
+		// shared by all bands. The resampling then ignores the transparent pixels whatever the data type.
+		vector<uint8_t> mask(static_cast<size_t>(4) * TILE_SIZE * TILE_SIZE);
+		if (mosaic->CreateMaskBand(GMF_PER_DATASET) != CE_None ||
+		    mosaic->GetRasterBand(band_count)
+		            ->RasterIO(GF_Read, 0, 0, 2 * TILE_SIZE, 2 * TILE_SIZE, mask.data(), 2 * TILE_SIZE, 2 * TILE_SIZE,
+		                       GDT_Byte, 0, 0) != CE_None) {
+			throw IOException("Could not build tile %d/%d/%d: %s", z, x, y, Raster::GetLastErrorMsg());
+		}
+		for (auto &value : mask) {
+			value = value ? 255 : 0;
+		}
+		if (mosaic->GetRasterBand(1)->GetMaskBand()->RasterIO(GF_Write, 0, 0, 2 * TILE_SIZE, 2 * TILE_SIZE,
+		                                                      mask.data(), 2 * TILE_SIZE, 2 * TILE_SIZE, GDT_Byte, 0,
+		                                                      0) != CE_None) {
+			throw IOException("Could not build tile %d/%d/%d: %s", z, x, y, Raster::GetLastErrorMsg());
+		}
+
+		// Downsample the mosaic, the mask excludes the transparent pixels
+		GDALRasterIOExtraArg extra_arg;
+		INIT_RASTERIO_EXTRA_ARG(extra_arg);
+		extra_arg.eResampleAlg = resample_alg;
+
+		for (int b = 1; b <= band_count; b++) {
+			if (mosaic->GetRasterBand(b)->RasterIO(GF_Read, 0, 0, 2 * TILE_SIZE, 2 * TILE_SIZE, buffer.data(),
+			                                       TILE_SIZE, TILE_SIZE, data_type, 0, 0, &extra_arg) != CE_None ||
+			    result->GetRasterBand(b)->RasterIO(GF_Write, 0, 0, TILE_SIZE, TILE_SIZE, buffer.data(), TILE_SIZE,
+			                                       TILE_SIZE, data_type, 0, 0) != CE_None) {
+				throw IOException("Could not build tile %d/%d/%d: %s", z, x, y, Raster::GetLastErrorMsg());
+			}
+		}
+		return HasData(*result) ? result.release() : nullptr;
+	}
+
+	//! Encodes a tile in the given image format
+	static string EncodeTile(GDALDataset &tile, const string &format, bool keep_alpha, int z, int x, int y) {
+		auto file_name = string(CPLSPrintf("/vsimem/rt_totiles_%p_%d_%d_%d", static_cast<void *>(&tile), z, x, y));
+
+		CPLStringList args;
+		args.AddString("-of");
+		args.AddString(format.c_str());
+		for (int b = 1; b <= tile.GetRasterCount() - (keep_alpha ? 0 : 1); b++) {
+			args.AddString("-b");
+			args.AddString(std::to_string(b).c_str());
+		}
+
+		auto options = GDALTranslateOptionsNew(args.List(), nullptr);
+		int usage_error = FALSE;
+		auto output = GDALTranslate(file_name.c_str(), GDALDataset::ToHandle(&tile), options, &usage_error);
+		GDALTranslateOptionsFree(options);
+
+		if (!output) {
+			VSIUnlink(file_name.c_str());
+			throw IOException("Could not encode tile %d/%d/%d as %s: %s", z, x, y, format, Raster::GetLastErrorMsg());
+		}
+		GDALClose(output);
+
+		vsi_l_offset size = 0;
+		auto data = VSIGetMemFileBuffer(file_name.c_str(), &size, FALSE);
+		string result(reinterpret_cast<const char *>(data), static_cast<size_t>(size));
+		VSIUnlink(file_name.c_str());
+		return result;
+	}
+
+	//! Validates the arguments and prepares the tiles of the deepest zoom level covering the raster
+	static void InitPyramid(GDALDataset *dataset, int min_zoom, int max_zoom, string format, const string &resampling,
+	                        Pyramid &pyramid) {
+		if (min_zoom < 0 || max_zoom > 24 || min_zoom > max_zoom) {
+			throw InvalidInputException("RT_ToTiles: the zoom levels must be in the [0, 24] range and min_zoom <= "
+			                            "max_zoom, got [%d, %d]",
+			                            min_zoom, max_zoom);
+		}
+		if (!dataset->GetSpatialRef()) {
+			throw InvalidInputException("RT_ToTiles: the raster has no coordinate reference system");
+		}
+
+		// Image formats are not registered at startup
+		GdalModule::RegisterAllDrivers();
+		format = StringUtil::Upper(format);
+		auto driver = GetGDALDriverManager()->GetDriverByName(format.c_str());
+		if (!driver || !driver->GetMetadataItem(GDAL_DCAP_CREATECOPY)) {
+			throw InvalidInputException("RT_ToTiles: unsupported tile format '%s'", format);
+		}
+
+		// Image formats would silently convert the values of other data types, e.g. Int16 bands in PNG
+		if (dataset->GetRasterCount() == 0) {
+			throw InvalidInputException("RT_ToTiles: the raster has no bands");
+		}
+		auto data_type_name = GDALGetDataTypeName(dataset->GetRasterBand(1)->GetRasterDataType());
+		auto data_types = driver->GetMetadataItem(GDAL_DMD_CREATIONDATATYPES);
+		if (data_types) {
+			auto supported_types = StringUtil::Split(data_types, ' ');
+			if (std::find(supported_types.begin(), supported_types.end(), data_type_name) == supported_types.end()) {
+				throw InvalidInputException("RT_ToTiles: the %s format does not support %s bands (supported types: "
+				                            "%s), rescale the raster first",
+				                            format, data_type_name, data_types);
+			}
+		}
+
+		// Tiles of the deepest zoom level covering the raster
+		double min_x, min_y, max_x, max_y;
+		if (!GetWebMercatorExtent(dataset, min_x, min_y, max_x, max_y)) {
+			throw InvalidInputException("RT_ToTiles: the extent of the raster can not be transformed to EPSG:3857");
+		}
+		auto tile_count = 1 << max_zoom;
+		auto tile_size = 2 * WEB_MERCATOR_HALF_SIZE / static_cast<double>(tile_count);
+		auto clamp_tile = [&](double value) {
+			return MinValue<int>(tile_count - 1, MaxValue<int>(0, static_cast<int>(std::floor(value))));
+		};
+		auto min_tile_x = clamp_tile((min_x + WEB_MERCATOR_HALF_SIZE) / tile_size);
+		auto max_tile_x = clamp_tile((max_x + WEB_MERCATOR_HALF_SIZE) / tile_size);
+		auto min_tile_y = clamp_tile((WEB_MERCATOR_HALF_SIZE - max_y) / tile_size);
+		auto max_tile_y = clamp_tile((WEB_MERCATOR_HALF_SIZE - min_y) / tile_size);
+
+		auto level_tile_count =
+		    static_cast<idx_t>(max_tile_x - min_tile_x + 1) * static_cast<idx_t>(max_tile_y - min_tile_y + 1);
+		if (level_tile_count > MAX_TILE_COUNT) {
+			throw InvalidInputException("RT_ToTiles: zoom level %d has %llu tiles, use a lower max_zoom", max_zoom,
+			                            level_tile_count);
+		}
+
+		pyramid.dataset = dataset;
+		pyramid.min_zoom = min_zoom;
+		pyramid.max_zoom = max_zoom;
+		pyramid.subtree_zoom = MaxValue(min_zoom, max_zoom - SUBTREE_DEPTH);
+		pyramid.min_tile_x = min_tile_x;
+		pyramid.min_tile_y = min_tile_y;
+		pyramid.max_tile_x = max_tile_x;
+		pyramid.max_tile_y = max_tile_y;
+		pyramid.format = format;
+		pyramid.keep_alpha = format != "JPEG";
+		pyramid.resample_alg = GetResampleAlgorithm(resampling);
+		pyramid.path.clear();
+		pyramid.next_root = 0;
+	}
+
+	//! Returns true if a tile of a zoom level contains tiles of the deepest zoom level covering the raster
+	static bool CoversRaster(const Pyramid &pyramid, int z, int x, int y) {
+		auto shift = pyramid.max_zoom - z;
+		return x >= (pyramid.min_tile_x >> shift) && x <= (pyramid.max_tile_x >> shift) &&
+		       y >= (pyramid.min_tile_y >> shift) && y <= (pyramid.max_tile_y >> shift);
+	}
+
+	static TileRecord MakeRecord(const Pyramid &pyramid, GDALDataset &tile, int z, int x, int y) {
+		TileRecord record;
+		record.z = z;
+		record.x = x;
+		record.y = y;
+		record.data = EncodeTile(tile, pyramid.format, pyramid.keep_alpha, z, x, y);
+		return record;
+	}
+
+	//! Generates the tiles of a subtree of the pyramid, from the tiles of the deepest zoom level warped from the source
+	//! up to its root. The tiles of a zoom level are built in parallel, each level is released once the next one is
+	//! built. Returns the root tile, or nullptr if it is empty.
+	static GDALDatasetUniquePtr GenerateSubtree(ClientContext &context, Pyramid &pyramid, int root_z, int root_x,
+	                                            int root_y, const string &resampling, vector<TileRecord> &records) {
+		auto depth = pyramid.max_zoom - root_z;
+		vector<PyramidTile> level;
+
+		for (int y = root_y << depth; y < (root_y + 1) << depth; y++) {
+			for (int x = root_x << depth; x < (root_x + 1) << depth; x++) {
+				if (CoversRaster(pyramid, pyramid.max_zoom, x, y)) {
+					PyramidTile tile;
+					tile.x = x;
+					tile.y = y;
+					level.push_back(std::move(tile));
+				}
+			}
+		}
+
+		for (int z = pyramid.max_zoom;; z--) {
+			auto is_deepest = z == pyramid.max_zoom;
+			vector<PyramidTile> children;
+			unordered_map<uint64_t, idx_t> children_index;
+
+			if (!is_deepest) {
+				// Empty tiles are not needed to build the next level
+				for (auto &tile : level) {
+					if (tile.dataset) {
+						children.push_back(std::move(tile));
+					}
+				}
+				level.clear();
+				unordered_map<uint64_t, idx_t> parent_index;
+
+				for (idx_t i = 0; i < children.size(); i++) {
+					auto &child = children[i];
+					children_index[GetTileKey(child.x, child.y)] = i;
+
+					auto parent_key = GetTileKey(child.x / 2, child.y / 2);
+					if (parent_index.find(parent_key) == parent_index.end()) {
+						parent_index[parent_key] = level.size();
+						PyramidTile parent;
+						parent.x = child.x / 2;
+						parent.y = child.y / 2;
+						level.push_back(std::move(parent));
+					}
+				}
+			}
+
+			RasterTileExecutor executor(context, is_deepest ? pyramid.dataset : nullptr);
+			executor.Execute(level.size(), [&](RasterTileReader &reader, idx_t tile_idx) {
+				auto &tile = level[tile_idx];
+				GDALDataset *result = nullptr;
+
+				if (is_deepest) {
+					reader.Access(
+					    [&](GDALDataset &source) { result = WarpTile(source, z, tile.x, tile.y, resampling); });
+				} else {
+					GDALDataset *tile_children[4] = {nullptr, nullptr, nullptr, nullptr};
+					for (int i = 0; i < 4; i++) {
+						auto entry = children_index.find(GetTileKey(2 * tile.x + i % 2, 2 * tile.y + i / 2));
+						if (entry != children_index.end()) {
+							tile_children[i] = children[entry->second].dataset.get();
+						}
+					}
+					result = DownsampleTile(z, tile.x, tile.y, tile_children, pyramid.resample_alg);
+				}
+				tile.dataset = GDALDatasetUniquePtr(result);
+
+				if (tile.dataset) {
+					auto record = MakeRecord(pyramid, *tile.dataset, z, tile.x, tile.y);
+					lock_guard<mutex> guard(executor.GetWriteLock());
+					records.push_back(std::move(record));
+				}
+			});
+
+			if (z == root_z) {
+				break;
+			}
+		}
+		return level.empty() ? nullptr : std::move(level[0].dataset);
+	}
+
+	//! Advances the depth-first generation of the pyramid until some tiles are encoded. Returns false once all the
+	//! tiles of the pyramid are generated.
+	static bool GeneratePyramidStep(ClientContext &context, Pyramid &pyramid, const string &resampling,
+	                                vector<TileRecord> &records) {
+		auto &path = pyramid.path;
+
+		while (records.empty()) {
+			if (path.empty()) {
+				// Start from the next tile of the lowest zoom level
+				auto shift = pyramid.max_zoom - pyramid.min_zoom;
+				auto root_min_x = pyramid.min_tile_x >> shift;
+				auto root_min_y = pyramid.min_tile_y >> shift;
+				auto root_cols = static_cast<idx_t>((pyramid.max_tile_x >> shift) - root_min_x + 1);
+				auto root_rows = static_cast<idx_t>((pyramid.max_tile_y >> shift) - root_min_y + 1);
+
+				if (pyramid.next_root >= root_cols * root_rows) {
+					return false;
+				}
+				path.emplace_back(pyramid.min_zoom, root_min_x + static_cast<int>(pyramid.next_root % root_cols),
+				                  root_min_y + static_cast<int>(pyramid.next_root / root_cols));
+				pyramid.next_root++;
+			}
+
+			auto &node = path.back();
+			GDALDatasetUniquePtr dataset;
+
+			if (node.z == pyramid.subtree_zoom) {
+				dataset = GenerateSubtree(context, pyramid, node.z, node.x, node.y, resampling, records);
+			} else if (node.next_child < 4) {
+				auto child_x = 2 * node.x + node.next_child % 2;
+				auto child_y = 2 * node.y + node.next_child / 2;
+				auto child_z = node.z + 1;
+				node.next_child++;
+
+				if (CoversRaster(pyramid, child_z, child_x, child_y)) {
+					path.emplace_back(child_z, child_x, child_y);
+				}
+				continue;
+			} else {
+				GDALDataset *children[4] = {node.children[0].get(), node.children[1].get(), node.children[2].get(),
+				                            node.children[3].get()};
+				dataset = GDALDatasetUniquePtr(DownsampleTile(node.z, node.x, node.y, children, pyramid.resample_alg));
+				if (dataset) {
+					records.push_back(MakeRecord(pyramid, *dataset, node.z, node.x, node.y));
+				}
+			}
+
+			// The tile is done, its children are released and it is handed to its parent
+			auto x = node.x;
+			auto y = node.y;
+			path.pop_back();
+			if (!path.empty()) {
+				auto &parent = path.back();
+				parent.children[(y - 2 * parent.y) * 2 + (x - 2 * parent.x)] = std::move(dataset);
+			}
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Execute
+	//------------------------------------------------------------------------------------------------------------------
+
+	static OperatorResultType Execute(ExecutionContext &context, TableFunctionInput &data_p, DataChunk &input,
+	                                  DataChunk &output) {
+		auto &bind_data = data_p.bind_data->Cast<BindData>();
+		auto &state = data_p.local_state->Cast<LocalState>();
+
+		while (state.input_idx < input.size()) {
+			if (!state.active) {
+				auto raster_value = input.data[0].GetValue(state.input_idx);
+				auto min_zoom_value = input.data[1].GetValue(state.input_idx);
+				auto max_zoom_value = input.data[2].GetValue(state.input_idx);
+				auto format_value = input.data[3].GetValue(state.input_idx);
+
+				if (raster_value.IsNull() || min_zoom_value.IsNull() || max_zoom_value.IsNull() ||
+				    format_value.IsNull()) {
+					state.input_idx++;
+					continue;
+				}
+				auto &raster = reinterpret_cast<RasterValue &>(raster_value);
+				InitPyramid(raster.get(), min_zoom_value.GetValue<int32_t>(), max_zoom_value.GetValue<int32_t>(),
+				            format_value.GetValue<string>(), bind_data.resampling, state.pyramid);
+				state.records.clear();
+				state.record_idx = 0;
+				state.active = true;
+			}
+
+			// Generate the next tiles once the previous ones are output
+			if (state.record_idx >= state.records.size()) {
+				state.records.clear();
+				state.record_idx = 0;
+
+				if (!GeneratePyramidStep(context.client, state.pyramid, bind_data.resampling, state.records)) {
+					state.pyramid.path.clear();
+					state.active = false;
+					state.input_idx++;
+				}
+				continue;
+			}
+
+			// And fill the output
+			idx_t count = 0;
+			auto z_data = FlatVector::GetData<int32_t>(output.data[0]);
+			auto x_data = FlatVector::GetData<int32_t>(output.data[1]);
+			auto y_data = FlatVector::GetData<int32_t>(output.data[2]);
+			auto blob_data = FlatVector::GetData<string_t>(output.data[3]);
+
+			for (; state.record_idx < state.records.size() && count < STANDARD_VECTOR_SIZE; state.record_idx++) {
+				auto &record = state.records[state.record_idx];
+				z_data[count] = record.z;
+				x_data[count] = record.x;
+				y_data[count] = record.y;
+				blob_data[count] = StringVector::AddStringOrBlob(output.data[3], record.data);
+				string().swap(record.data);
+				count++;
+			}
+			output.SetCardinality(count);
+			return OperatorResultType::HAVE_MORE_OUTPUT;
+		}
+
+		state.input_idx = 0;
+		output.SetCardinality(0);
+		return OperatorResultType::NEED_MORE_INPUT;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Documentation
+	//------------------------------------------------------------------------------------------------------------------
+
+	static constexpr auto DOCUMENTATION = R"(
+	    Renders a raster as a pyramid of XYZ web map tiles (Web Mercator, 256x256 pixels) between two zoom levels.
+
+	    The pyramid is generated depth-first: the tiles of the deepest zoom level under a tile three levels above it are warped from the raster in parallel, then the tiles above them are built from their four children, without reading the raster again. Empty tiles are skipped. Tiles are returned as soon as they are encoded, and only the children of the tiles being built are held in memory, so the memory used does not grow with the size of the raster.
+
+	    Each tile is returned as a row with its zoom level, column and row (with the origin at the top-left corner, as in XYZ services) and the encoded image. The rows can be stored in a table, or written with `COPY` to build a tile folder or an MBTiles database.
+
+	    | Parameter | Type | Description |
+	    | --------- | -----| ----------- |
+	    | `raster` | RASTER | The raster to render, it must have a coordinate reference system. Mandatory |
+	    | `min_zoom` | INTEGER | The lowest zoom level. Mandatory |
+	    | `max_zoom` | INTEGER | The deepest zoom level, in the [0, 24] range. Mandatory |
+	    | `format` | VARCHAR | The name of the GDAL driver used to encode the tiles (e.g. PNG, JPEG or WEBP). Mandatory |
+	    | `resampling` | VARCHAR | The resampling method: near (default), bilinear, cubic, average or mode. |
+
+	    The bands of the raster must be compatible with the format, e.g. 1 or 3 bands of 8-bit values for JPEG, or 8 or 16-bit values for PNG; other data types are rejected and must be rescaled first. A transparency band is added for formats supporting it, transparent pixels are ignored when the tiles of the lower zoom levels are resampled.
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		SELECT t.z, t.x, t.y, t.blob FROM RT_Read('some/file/path/filename.tif') r, RT_ToTiles(r.raster, 0, 12, 'PNG') t;
+	)";
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Register
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void Register(DatabaseInstance &db) {
+		TableFunction func("RT_ToTiles",
+		                   {RasterTypes::RASTER(), LogicalType::INTEGER, LogicalType::INTEGER, LogicalType::VARCHAR},
+		                   nullptr, Bind, nullptr, InitLocal);
+		func.in_out_function = Execute;
+		func.named_parameters["resampling"] = LogicalType::VARCHAR;
+		ExtensionUtil::RegisterFunction(db, func);
+
+		FunctionBuilder::AddTableFunctionDocs(db, "RT_ToTiles", DOCUMENTATION, EXAMPLE, {{"ext", "spatial_raster"}});
+	}
+};
+
+//======================================================================================================================
+// RT_Zip
+//======================================================================================================================
+
+struct RT_Zip {
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Bind
+	//------------------------------------------------------------------------------------------------------------------
+
+	struct BindData final : TableFunctionData {
+		int band_a;
+		int band_b;
+	};
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
+		return_types.emplace_back(LogicalType::INTEGER);
+		return_types.emplace_back(LogicalType::INTEGER);
+		return_types.emplace_back(LogicalType::DOUBLE);
+		return_types.emplace_back(LogicalType::DOUBLE);
+		names.emplace_back("col");
+		names.emplace_back("row");
+		names.emplace_back("value_a");
+		names.emplace_back("value_b");
+
+		auto result = make_uniq<BindData>();
+		result->band_a = 1;
+		result->band_b = 1;
+
+		for (auto &kv : input.named_parameters) {
+			if (kv.first == "band_a") {
+				result->band_a = kv.second.GetValue<int32_t>();
+			} else if (kv.first == "band_b") {
+				result->band_b = kv.second.GetValue<int32_t>();
+			}
+		}
+		return std::move(result);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Init Local
+	//------------------------------------------------------------------------------------------------------------------
+
+	//! A raster being zipped, with its values of the current block (NODATA values are NaN)
+	struct ZipInput {
+		GDALDataset *dataset;
+		int band_number;
+		bool has_nodata;
+		double nodata_value;
+		vector<double> values;
+	};
+
+	struct LocalState final : LocalTableFunctionState {
+		idx_t input_idx;
+		bool active;
+		ZipInput a;
+		ZipInput b;
+		vector<RasterWindow> blocks;
+		idx_t block_idx;
+		idx_t pixel_idx;
+		idx_t pixel_count;
+		explicit LocalState() : input_idx(0), active(false), block_idx(0), pixel_idx(0), pixel_count(0) {
+		}
+	};
+
+	static unique_ptr<LocalTableFunctionState> InitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+	                                                     GlobalTableFunctionState *global_state) {
+		return make_uniq_base<LocalTableFunctionState, LocalState>();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Read
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void InitInput(ZipInput &input, GDALDataset *dataset, int band_number) {
+		if (band_number < 1 || band_number > dataset->GetRasterCount()) {
+			throw InvalidInputException("Band %d out of range, the raster has %d bands", band_number,
+			                            dataset->GetRasterCount());
+		}
+		int has_nodata = FALSE;
+		input.dataset = dataset;
+		input.band_number = band_number;
+		input.nodata_value = dataset->GetRasterBand(band_number)->GetNoDataValue(&has_nodata);
+		input.has_nodata = has_nodata != FALSE;
+	}
+
+	static void ReadBlock(ZipInput &input, const RasterWindow &block) {
+		input.values.resize(static_cast<size_t>(block.x_size) * block.y_size);
+
+		auto band = input.dataset->GetRasterBand(input.band_number);
+		if (band->RasterIO(GF_Read, block.x_off, block.y_off, block.x_size, block.y_size, input.values.data(),
+		                   block.x_size, block.y_size, GDT_Float64, 0, 0) != CE_None) {
+			throw IOException("Could not read raster window (%d, %d, %d, %d) of band %d", block.x_off, block.y_off,
+			                  block.x_size, block.y_size, input.band_number);
+		}
+		if (input.has_nodata) {
+			const double nan_value = std::numeric_limits<double>::quiet_NaN();
+			for (auto &value : input.values) {
+				value = value == input.nodata_value ? nan_value : value;
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Execute
+	//------------------------------------------------------------------------------------------------------------------
+
+	static OperatorResultType Execute(ExecutionContext &context, TableFunctionInput &data_p, DataChunk &input,
+	                                  DataChunk &output) {
+		auto &bind_data = data_p.bind_data->Cast<BindData>();
+		auto &state = data_p.local_state->Cast<LocalState>();
+
+		while (state.input_idx < input.size()) {
+			if (!state.active) {
+				auto raster_a_value = input.data[0].GetValue(state.input_idx);
+				auto raster_b_value = input.data[1].GetValue(state.input_idx);
+
+				if (raster_a_value.IsNull() || raster_b_value.IsNull()) {
+					state.input_idx++;
+					continue;
+				}
+				auto &raster_a = reinterpret_cast<RasterValue &>(raster_a_value);
+				auto &raster_b = reinterpret_cast<RasterValue &>(raster_b_value);
+				InitInput(state.a, raster_a.get(), bind_data.band_a);
+				InitInput(state.b, raster_b.get(), bind_data.band_b);
+
+				if (state.a.dataset->GetRasterXSize() != state.b.dataset->GetRasterXSize() ||
+				    state.a.dataset->GetRasterYSize() != state.b.dataset->GetRasterYSize()) {
+					throw InvalidInputException("RT_Zip: the rasters must have the same size, use RT_Align to "
+					                            "resample one of them onto the grid of the other");
+				}
+				if (!Raster(state.a.dataset).HasSameGrid(state.b.dataset)) {
+					throw InvalidInputException("RT_Zip: the rasters must have the same grid (geotransform and "
+					                            "coordinate system), use RT_Align to resample one of them onto the "
+					                            "grid of the other");
+				}
+
+				// Matching blocks of both rasters are read together, following the blocks of the first one
+				state.blocks = Raster(state.a.dataset).GetTiles(state.a.band_number);
+				state.block_idx = 0;
+				state.pixel_idx = 0;
+				state.pixel_count = 0;
+				state.active = true;
+			}
+
+			if (state.pixel_idx >= state.pixel_count) {
+				if (state.block_idx >= state.blocks.size()) {
+					state.active = false;
+					state.input_idx++;
+					continue;
+				}
+				auto &block = state.blocks[state.block_idx++];
+				ReadBlock(state.a, block);
+				ReadBlock(state.b, block);
+				state.pixel_idx = 0;
+				state.pixel_count = static_cast<idx_t>(block.x_size) * block.y_size;
+			}
+
+			// And fill the output
+			auto &block = state.blocks[state.block_idx - 1];
+			auto count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, state.pixel_count - state.pixel_idx);
+			auto col_data = FlatVector::GetData<int32_t>(output.data[0]);
+			auto row_data = FlatVector::GetData<int32_t>(output.data[1]);
+			auto a_data = FlatVector::GetData<double>(output.data[2]);
+			auto b_data = FlatVector::GetData<double>(output.data[3]);
+
+			for (idx_t i = 0; i < count; i++) {
+				auto p = state.pixel_idx + i;
+				col_data[i] = block.x_off + static_cast<int>(p % block.x_size);
+				row_data[i] = block.y_off + static_cast<int>(p / block.x_size);
+				a_data[i] = state.a.values[p];
+				b_data[i] = state.b.values[p];
+
+				if (std::isnan(a_data[i])) {
+					FlatVector::SetNull(output.data[2], i, true);
+				}
+				if (std::isnan(b_data[i])) {
+					FlatVector::SetNull(output.data[3], i, true);
+				}
+			}
+			state.pixel_idx += count;
+			output.SetCardinality(count);
+			return OperatorResultType::HAVE_MORE_OUTPUT;
+		}
+
+		state.input_idx = 0;
+		output.SetCardinality(0);
+		return OperatorResultType::NEED_MORE_INPUT;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Documentation
+	//------------------------------------------------------------------------------------------------------------------
+
+	static constexpr auto DOCUMENTATION = R"(
+	    Returns the values of the matching pixels of two rasters with the same grid.
+
+	    The rasters are read together block by block, so combining two rasters costs about the same as reading them once, instead of expanding both to pixels and joining them by their coordinates. Rasters with different grids can be aligned first with [RT_Align](#rt_align), which resamples one of them lazily while the blocks are read.
+
+	    Each pixel is returned as a row with its column and row and the values of both rasters. NODATA values are NULL.
+
+	    | Parameter | Type | Description |
+	    | --------- | -----| ----------- |
+	    | `raster_a` | RASTER | The first raster. Mandatory |
+	    | `raster_b` | RASTER | The second raster, with the same grid (size, geotransform and coordinate system) as the first one. Mandatory |
+	    | `band_a` | INTEGER | The band number (1-based) of the first raster, 1 by default. |
+	    | `band_b` | INTEGER | The band number (1-based) of the second raster, 1 by default. |
+	)";
+
+	static constexpr auto EXAMPLE = R"(
+		SELECT z.value_b AS landcover, AVG(z.value_a) AS elevation
+		FROM RT_Read('some/file/path/dem.tif') dem, RT_Read('some/file/path/landcover.tif') lc,
+		     RT_Zip(RT_Align(dem.raster, lc.raster, 'bilinear'), lc.raster) z
+		GROUP BY ALL;
+	)";
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Register
+	//------------------------------------------------------------------------------------------------------------------
+
+	static void Register(DatabaseInstance &db) {
+		TableFunction func("RT_Zip", {RasterTypes::RASTER(), RasterTypes::RASTER()}, nullptr, Bind, nullptr,
+		                   InitLocal);
+		func.in_out_function = Execute;
+		func.named_parameters["band_a"] = LogicalType::INTEGER;
+		func.named_parameters["band_b"] = LogicalType::INTEGER;
+		ExtensionUtil::RegisterFunction(db, func);
+
+		FunctionBuilder::AddTableFunctionDocs(db, "RT_Zip", DOCUMENTATION, EXAMPLE, {{"ext", "spatial_raster"}});
+	}
+};
+
 } // namespace
 
 // ######################################################################################################################
@@ -344,6 +2827,11 @@ void GdalRasterTableFunctions::Register(DatabaseInstance &db) {
 	// Register functions
 	RT_Drivers::Register(db);
 	RT_Read::Register(db);
+	RT_ReadStack::Register(db);
+	RT_ReadMultiDim::Register(db);
+	RT_Polygonize::Register(db);
+	RT_ToTiles::Register(db);
+	RT_Zip::Register(db);
 }
 
 } // namespace duckdb
@@ -0,0 +1,128 @@
+#include "raster_tile_executor.hpp"
+#include "gdal_dataset_factory.hpp"
+
+// DuckDB
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+// GDAL
+#include "gdal_priv.h"
+
+namespace duckdb {
+
+//======================================================================================================================
+// RasterTileReader
+//======================================================================================================================
+
+RasterTileReader::RasterTileReader(GDALDataset *source, mutex &lock) : source(source), dataset(nullptr), lock(lock) {
+	if (source) {
+		dataset = GDALDatasetFactory::Reopen(source);
+	}
+}
+
+RasterTileReader::~RasterTileReader() {
+	if (dataset) {
+		GDALClose(GDALDataset::ToHandle(dataset));
+	}
+}
+
+GDALDataset *RasterTileReader::GetSource() const {
+	return source;
+}
+
+void RasterTileReader::Read(int band_number, const RasterWindow &window, GDALDataType data_type, void *buffer,
+                            int buffer_x_size, int buffer_y_size) {
+	CPLErr err;
+
+	if (dataset) {
+		auto band = dataset->GetRasterBand(band_number);
+		err = band->RasterIO(GF_Read, window.x_off, window.y_off, window.x_size, window.y_size, buffer, buffer_x_size,
+		                     buffer_y_size, data_type, 0, 0);
+	} else {
+		lock_guard<mutex> guard(lock);
+		auto band = source->GetRasterBand(band_number);
+		err = band->RasterIO(GF_Read, window.x_off, window.y_off, window.x_size, window.y_size, buffer, buffer_x_size,
+		                     buffer_y_size, data_type, 0, 0);
+	}
+	if (err != CE_None) {
+		throw IOException("Could not read raster window (%d, %d, %d, %d) of band %d", window.x_off, window.y_off,
+		                  window.x_size, window.y_size, band_number);
+	}
+}
+
+void RasterTileReader::Access(const std::function<void(GDALDataset &dataset)> &function) {
+	if (dataset) {
+		function(*dataset);
+	} else {
+		lock_guard<mutex> guard(lock);
+		function(*source);
+	}
+}
+
+//======================================================================================================================
+// RasterTileExecutor
+//======================================================================================================================
+
+namespace {
+
+class RasterTileTask final : public BaseExecutorTask {
+public:
+	RasterTileTask(TaskExecutor &executor, GDALDataset *dataset, mutex &lock, atomic<idx_t> &next_tile,
+	               idx_t tile_count, const RasterTileExecutor::tile_function_t &function)
+	    : BaseExecutorTask(executor), dataset(dataset), lock(lock), next_tile(next_tile), tile_count(tile_count),
+	      function(function) {
+	}
+
+	void ExecuteTask() override {
+		RasterTileReader reader(dataset, lock);
+
+		for (idx_t tile_idx = next_tile++; tile_idx < tile_count; tile_idx = next_tile++) {
+			if (executor.HasError()) {
+				return;
+			}
+			function(reader, tile_idx);
+		}
+	}
+
+private:
+	GDALDataset *dataset;
+	mutex &lock;
+	atomic<idx_t> &next_tile;
+	idx_t tile_count;
+	const RasterTileExecutor::tile_function_t &function;
+};
+
+} // namespace
+
+RasterTileExecutor::RasterTileExecutor(ClientContext &context, GDALDataset *dataset)
+    : context(context), dataset(dataset) {
+}
+
+void RasterTileExecutor::Execute(idx_t tile_count, const tile_function_t &function) {
+	if (tile_count == 0) {
+		return;
+	}
+
+	// One worker per thread, each worker pulls tiles until there are no more left
+	auto &scheduler = TaskScheduler::GetScheduler(context);
+	auto thread_count = MaxValue<idx_t>(1, NumericCast<idx_t>(scheduler.NumberOfThreads()));
+	auto worker_count = MinValue<idx_t>(thread_count, tile_count);
+
+	atomic<idx_t> next_tile(0);
+	TaskExecutor executor(context);
+
+	for (idx_t i = 0; i < worker_count; i++) {
+		executor.ScheduleTask(make_uniq<RasterTileTask>(executor, dataset, read_lock, next_tile, tile_count, function));
+	}
+	executor.WorkOnTasks();
+
+	if (executor.HasError()) {
+		executor.ThrowError();
+	}
+}
+
+mutex &RasterTileExecutor::GetWriteLock() {
+	return write_lock;
+}
+
+} // namespace duckdb
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "raster.hpp"
+#include "gdal.h"
+
+#include <functional>
+
+class GDALDataset;
+
+namespace duckdb {
+
+class ClientContext;
+
+//! A per-worker handle of a Raster (GDALDataset) to read pixel windows concurrently.
+//! GDALDatasets are not thread-safe, so the worker reopens the source dataset when possible,
+//! otherwise reads are serialized with the lock shared by all workers of the executor.
+class RasterTileReader {
+public:
+	//! Constructor
+	RasterTileReader(GDALDataset *source, mutex &lock);
+	//! Destructor
+	~RasterTileReader();
+
+	//! Returns the source dataset, pixels must be read using the Read method.
+	GDALDataset *GetSource() const;
+
+	//! Reads a window of a band into a buffer of the given data type and size.
+	void Read(int band_number, const RasterWindow &window, GDALDataType data_type, void *buffer, int buffer_x_size,
+	          int buffer_y_size);
+
+	//! Runs a function with the dataset handle of this worker (e.g. to warp it), the function is serialized with the
+	//! other workers when the handle is the shared source dataset.
+	void Access(const std::function<void(GDALDataset &dataset)> &function);
+
+private:
+	GDALDataset *source;
+	GDALDataset *dataset;
+	mutex &lock;
+};
+
+//! Runs a function over the tiles of a Raster in parallel using the TaskScheduler of DuckDB.
+class RasterTileExecutor {
+public:
+	typedef std::function<void(RasterTileReader &reader, idx_t tile_idx)> tile_function_t;
+
+	//! Constructor, the dataset can be null when the tasks do not read pixels.
+	RasterTileExecutor(ClientContext &context, GDALDataset *dataset);
+
+	//! Executes the function for all tile indexes in [0, tile_count), waits for all tiles to finish.
+	void Execute(idx_t tile_count, const tile_function_t &function);
+
+	//! Returns the lock to serialize writes of the workers into shared objects (e.g. an output dataset).
+	mutex &GetWriteLock();
+
+private:
+	ClientContext &context;
+	GDALDataset *dataset;
+	mutex read_lock;
+	mutex write_lock;
+};
+
+} // namespace duckdb
@@ -15,6 +15,12 @@ LogicalType RasterTypes::RASTER_COORD() {
 	return type;
 }
 
+LogicalType RasterTypes::WKB_BLOB() {
+	auto type = LogicalType(LogicalTypeId::BLOB);
+	type.SetAlias("WKB_BLOB");
+	return type;
+}
+
 void RasterTypes::Register(DatabaseInstance &db) {
 
 	// RASTER
@@ -11,6 +11,9 @@ struct LogicalType;
 struct RasterTypes {
 	static LogicalType RASTER();
 	static LogicalType RASTER_COORD();
+	//! A WKB geometry, compatible with the WKB_BLOB type of the spatial extension.
+	//! Not registered here, the spatial extension owns it and provides the casts to GEOMETRY.
+	static LogicalType WKB_BLOB();
 
 	static void Register(DatabaseInstance &db);
 };
@@ -11,6 +11,8 @@
 #include "gdal_module.hpp"
 #include "raster_types.hpp"
 #include "raster_table_functions.hpp"
+#include "raster_scalar_functions.hpp"
+#include "raster_aggregate_functions.hpp"
 #include "raster_casts_functions.hpp"
 
 namespace duckdb {
@@ -26,6 +28,12 @@ static void LoadInternal(DatabaseInstance &instance) {
 	// Register the Table functions
 	GdalRasterTableFunctions::Register(instance);
 
+	// Register the Scalar functions
+	GdalRasterScalarFunctions::Register(instance);
+
+	// Register the Aggregate functions
+	GdalRasterAggregateFunctions::Register(instance);
+
 	// Register the Casts functions
 	GdalRasterCastsFunctions::Register(instance);
 }